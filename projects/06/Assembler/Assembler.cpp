@@ -10,105 +10,660 @@ bool Assembler::isASMFile(const std::string path) const {
     return path.find(".asm") != std::string::npos;
 }
 
-int Assembler::writePart(SymbolType type) {
-    std::string (Code::*toBinary)(const std::string&) const;
-    std::string (Parser::*syntax)() const;
-
-    if (type == SymbolType::address) {
-        toBinary = &Code::address;
-        syntax = &Parser::symbol;
-    } else if (type == SymbolType::comp) {
-        toBinary = &Code::comp;
-        syntax = &Parser::comp;
-    } else if (type == SymbolType::dest) {
-        toBinary = &Code::dest;
-        syntax = &Parser::dest;
-    } else if (type == SymbolType::jump) {
-        toBinary = &Code::jump;
-        syntax = &Parser::jump;
-    } else {
-        throw functionCallException("Incorrect Symbol Type (Parse line: " + std::to_string(parser_->getCurrentCommandFileLine()) + ")");
+uint16_t Assembler::encodeSymbol(std::string_view symbol) {
+    if (code_->canTranslateToBinary(symbol, SymbolType::address)) return code_->address(symbol);
+    int id = symbol_table_->findOrInsert(symbol);
+    if (symbol_table_->isDefined(id)) return code_->address(symbol_table_->addressOf(id));
+    /* A static gets the next address only if no earlier symbol is pending, so the order matches file mode. */
+    if (stream_ != nullptr && fixups_.empty() && isStreamVariable(symbol)) return code_->address(addFirstUseVariable(id));
+    if (option_.single_pass) {
+        fixups_.push_back({word_count_, id});
+        return 0;
     }
+    return code_->address(symbol_table_->addVariable(id));
+}
+
+std::string Assembler::describe(const Command& command) const {
+    if (command.type == CommandType::address)
+        return "ADDRESS: " + std::string(command.symbol) + "(Parse line: " + std::to_string(command.line) + ")";
+    return "COMP: " + std::string(command.comp) + ", DEST: " + std::string(command.dest) + ", JUMP: " + std::string(command.jump) + "(Parse line: " + std::to_string(command.line) + ")";
+}
+
+void Assembler::report(const Command& command) {
+    diagnostics_.push_back({command.line, "Translate Exception: fail to translate command(" + describe(command) + ")."});
+}
+
+bool Assembler::isAddress(std::string_view symbol) const {
+    return code_->canTranslateToBinary(symbol, SymbolType::address) || Code::isSymbol(symbol);
+}
+
+uint16_t Assembler::encodeACommand(const Command& command) {
+    if (isAddress(command.symbol)) return encodeSymbol(command.symbol);
+    report(command);
+    return 0;
+}
+
+uint16_t Assembler::encodeCommand(const Command& command) {
+    if (command.type == CommandType::address) return encodeACommand(command);
+    uint16_t word = 0;
+    if (!encodeCCommand(command, word)) report(command);
+    return word;
+}
+
+bool Assembler::encodeResolvedACommand(const Command& command, uint16_t& word) const {
+    word = 0;
+    if (code_->canTranslateToBinary(command.symbol, SymbolType::address)) {
+        word = code_->address(command.symbol);
+        return true;
+    }
+    if (!Code::isSymbol(command.symbol)) return false;
+    word = code_->address(symbol_table_->addressOf(symbol_table_->find(command.symbol)));
+    return true;
+}
+
+bool Assembler::encodeCCommand(const Command& command, uint16_t& word) const {
+    int code = code_->encodeCompute(command.dest, command.comp, command.jump);
+    word = (code < 0) ? 0 : static_cast<uint16_t>(code);
+    return code >= 0;
+}
 
-    std::string result = "";
-    if (code_->canTranslateToBinary((parser_->*syntax)(), type)) {
-        result = (code_->*toBinary)((parser_->*syntax)());
-    } else if (symbol_table_->contains((parser_->*syntax)())) {
-        result = code_->address(symbol_table_->GetAddress((parser_->*syntax)()));
+int Assembler::wordWidth() const {
+    return (option_.format == OutputFormat::binary) ? 2 : 17;
+}
+
+void Assembler::renderWord(uint16_t word, char* buffer) const {
+    if (option_.format == OutputFormat::binary) {
+        buffer[0] = static_cast<char>(word & 0xff);
+        buffer[1] = static_cast<char>(word >> 8);
     } else {
-        result = code_->address(symbol_table_->addVariable((parser_->*syntax)()));
+        Code::toText(word, buffer);
+        buffer[16] = '\n';
     }
-    output_ << result;
-    return static_cast<int>(result.size());
 }
 
-void Assembler::writeACommand() {
-    try {
-        int length = 1;
-        output_ << "0";
-        length += writePart(SymbolType::address);
-        if (length != 16) throw std::exception();
-    } catch (functionCallException& e) {
-        throw e;
-    } catch (std::exception& e) {
-        throw translateException("ADDRESS: " + parser_->symbol() + "(Parse line: " + std::to_string(parser_->getCurrentCommandFileLine()) + ")");
+void Assembler::writeWord(uint16_t word) {
+    ++word_count_;
+    if (words_ != nullptr) {
+        words_->push_back(word);
+        return;
     }
+    char buffer[17];
+    renderWord(word, buffer);
+    output_.write(buffer, wordWidth());
 }
 
-void Assembler::writeCCommand() {
-    try {
-        int length = 3;
-        output_ << "111";
-        length += writePart(SymbolType::comp);
-        length += writePart(SymbolType::dest);
-        length += writePart(SymbolType::jump);
-        if (length != 16) throw std::exception();
-    } catch (functionCallException& e) {
-        throw e;
-    } catch (std::exception& e) {
-        throw translateException("COMP: " + parser_->comp() + ", DEST: " + parser_->dest() + ", JUMP: " + parser_->jump() + "(Parse line: " + std::to_string(parser_->getCurrentCommandFileLine()) + ")");
+void Assembler::writeWords(const std::vector<uint16_t>& words, const std::vector<char>& rendered, std::size_t count) {
+    word_count_ += count;
+    if (words_ != nullptr) words_->insert(words_->end(), words.begin(), words.begin() + count);
+    else output_.write(rendered.data(), count * wordWidth());
+}
+
+void Assembler::advanceParser() {
+    if (option_.stats == StatsFormat::none) {
+        parser_->advance();
+        return;
     }
+    PhaseTimer timer(stats_.parse);
+    parser_->advance();
 }
 
 void Assembler::pass1() {
+    stats_.commands = 0;
     while (parser_->hasMoreCommands()) {
-        parser_->advance();
-        if (parser_->commandType() == CommandType::label)
+        advanceParser();
+        if (parser_->commandType() != CommandType::nothing) ++stats_.commands;
+        if (parser_->commandType() == CommandType::label) {
             symbol_table_->addEntry(parser_->symbol(), parser_->getCommandAddress()+1);
+            ++stats_.label_count;
+        }
     }
     parser_->resetCursor();
 }
 
 void Assembler::pass2() {
+    /* Words in front of the first symbol were written by symbolFreePass. */
+    const int written = static_cast<int>(word_count_);
+    while (parser_->hasMoreCommands()) {
+        advanceParser();
+        if (parser_->getCommandAddress() < written) continue;
+        if (parser_->commandType() == CommandType::address || parser_->commandType() == CommandType::compute)
+            writeWord(encodeCommand(parser_->command()));
+    }
+}
+
+bool Assembler::symbolFreePass() {
+    while (parser_->hasMoreCommands()) {
+        advanceParser();
+        CommandType type = parser_->commandType();
+        if (type != CommandType::nothing) ++stats_.commands;
+        if (type == CommandType::label) return false;
+        if (type == CommandType::address) {
+            std::string_view symbol = parser_->symbol();
+            if (!code_->canTranslateToBinary(symbol, SymbolType::address)) return false;
+            writeWord(code_->address(symbol));
+        } else if (type == CommandType::compute) {
+            writeWord(encodeCommand(parser_->command()));
+        }
+    }
+    return true;
+}
+
+void Assembler::singlePass() {
+    /* symbolFreePass stopped at the current command, so it is translated first. */
+    for (bool current = true; current || parser_->hasMoreCommands(); current = false) {
+        if (!current) {
+            advanceParser();
+            if (parser_->commandType() != CommandType::nothing) ++stats_.commands;
+        }
+        if (parser_->commandType() == CommandType::label) {
+            symbol_table_->addEntry(parser_->symbol(), parser_->getCommandAddress()+1);
+            ++stats_.label_count;
+            continue;
+        }
+        if (parser_->commandType() == CommandType::address || parser_->commandType() == CommandType::compute)
+            writeWord(encodeCommand(parser_->command()));
+    }
+}
+
+void Assembler::patchFixups() {
+    std::streampos end = (words_ == nullptr) ? output_.tellp() : std::streampos(0);
+    for (const Fixup& fixup : fixups_) {
+        int address = 0;
+        if (symbol_table_->isDefined(fixup.symbol)) address = symbol_table_->addressOf(fixup.symbol);
+        else address = symbol_table_->addVariable(fixup.symbol);
+
+        /* Every word has the same width, so the word index gives the file position. */
+        if (words_ != nullptr) {
+            (*words_)[fixup.index] = code_->address(address);
+        } else {
+            output_.seekp(static_cast<std::streamoff>(fixup.index * wordWidth()));
+            char buffer[17];
+            renderWord(code_->address(address), buffer);
+            output_.write(buffer, wordWidth());
+        }
+    }
+    if (words_ == nullptr) output_.seekp(end);
+    fixups_.clear();
+}
+
+void Assembler::collectCommands() {
     while (parser_->hasMoreCommands()) {
         parser_->advance();
-        if (parser_->commandType() == CommandType::address) writeACommand();
-        else if (parser_->commandType() == CommandType::compute) writeCCommand();
-        else continue;
-        output_ << std::endl;
+        if (parser_->commandType() == CommandType::nothing) continue;
+
+        Command command = parser_->command();
+        if (!parser_->isMappedCommand()) {
+            /* Compacted commands live in the parser's scratch buffer. Keep own copies. */
+            for (std::string_view* field : {&command.symbol, &command.dest, &command.comp, &command.jump}) {
+                owned_fields_.emplace_back(*field);
+                *field = owned_fields_.back();
+            }
+        }
+        commands_.push_back(command);
+    }
+    stats_.commands = commands_.size();
+}
+
+void Assembler::optimizeCommands() {
+    /* The optimizer may remove invalid commands. Leave them to be reported by encoding. */
+    uint16_t word = 0;
+    for (const Command& command : commands_) {
+        if (command.type == CommandType::address && !isAddress(command.symbol)) return;
+        if (command.type == CommandType::compute && !encodeCCommand(command, word)) return;
+    }
+    Optimizer optimizer;
+    saved_words_ = optimizer.optimize(commands_);
+}
+
+void Assembler::defineLabels() {
+    /* Labels are kept in commands_ until here(the optimizer may move them). */
+    std::size_t address = 0;
+    for (const Command& command : commands_) {
+        if (command.type != CommandType::label) {
+            if (option_.map) source_map_.addWord(static_cast<uint32_t>(command.line));
+            commands_[address++] = command;
+            continue;
+        }
+        symbol_table_->addEntry(command.symbol, static_cast<int>(address));
+        if (option_.map) source_map_.addLabel(command.symbol, static_cast<uint32_t>(address));
+        ++stats_.label_count;
+    }
+    commands_.resize(address);
+}
+
+void Assembler::allocateVariables() {
+    for (const Command& command : commands_) {
+        if (command.type != CommandType::address) continue;
+        if (code_->canTranslateToBinary(command.symbol, SymbolType::address) || !Code::isSymbol(command.symbol)) continue;
+        int id = symbol_table_->findOrInsert(command.symbol);
+        if (!symbol_table_->isDefined(id)) symbol_table_->addVariable(id);
+    }
+}
+
+void Assembler::parallelEncode() {
+    const std::size_t CHUNK_SIZE = 16384;
+    const std::size_t count = commands_.size();
+    const std::size_t chunks = (count + CHUNK_SIZE - 1) / CHUNK_SIZE;
+    const std::size_t width = static_cast<std::size_t>(wordWidth());
+    const bool render = (words_ == nullptr);
+    std::vector<uint16_t> words(count);
+    std::vector<char> buffer(render ? count * width : 0);
+
+    /* Failed commands of each chunk. They are reported in order after encoding. */
+    std::vector<std::vector<std::size_t>> failed(chunks);
+    std::atomic<std::size_t> next_chunk(0);
+
+    auto worker = [&]() {
+        for (std::size_t chunk = next_chunk++; chunk < chunks; chunk = next_chunk++) {
+            std::size_t end = std::min(count, (chunk + 1) * CHUNK_SIZE);
+            for (std::size_t i = chunk * CHUNK_SIZE; i < end; ++i) {
+                const Command& command = commands_[i];
+                bool encoded = (command.type == CommandType::address) ? encodeResolvedACommand(command, words[i]) : encodeCCommand(command, words[i]);
+                if (!encoded) failed[chunk].push_back(i);
+                if (render) renderWord(words[i], &buffer[i * width]);
+            }
+        }
+    };
+
+    std::size_t thread_count = (option_.threads > 0) ? option_.threads : std::max(1u, std::thread::hardware_concurrency());
+    thread_count = std::min(thread_count, std::max<std::size_t>(chunks, 1));
+    {
+        PhaseTimer timer(stats_.encode);
+        std::vector<std::thread> threads;
+        for (std::size_t i = 1; i < thread_count; ++i) threads.emplace_back(worker);
+        worker();
+        for (std::thread& thread : threads) thread.join();
+    }
+
+    for (const std::vector<std::size_t>& indexes : failed) {
+        for (std::size_t i : indexes) report(commands_[i]);
+    }
+    PhaseTimer timer(stats_.write);
+    writeWords(words, buffer, count);
+}
+
+bool Assembler::isLabelLine(std::string_view line) const {
+    string_iter begin = line.find_first_not_of(" \t\r");
+    return begin != string_end && line[begin] == '(';
+}
+
+Region Assembler::encodeRegion(std::string_view text, int first_line, uint64_t hash) const {
+    Region region = {hash, true, static_cast<uint32_t>(text.size()), {}, {}, {}};
+    Parser parser;
+    parser.setSource(text);
+    while (parser.hasMoreCommands()) {
+        parser.advance();
+        Command command = parser.command();
+        command.line += first_line - 1;
+        uint32_t offset = static_cast<uint32_t>(region.words.size());
+        if (command.type == CommandType::label) {
+            region.labels.push_back({std::string(command.symbol), offset});
+        } else if (command.type == CommandType::address) {
+            if (code_->canTranslateToBinary(command.symbol, SymbolType::address)) {
+                region.words.push_back(code_->address(command.symbol));
+            } else {
+                /* A cached region must be valid, so an error stops here. */
+                if (!Code::isSymbol(command.symbol)) throw translateException(describe(command), command.line);
+                region.relocations.push_back({offset, std::string(command.symbol)});
+                region.words.push_back(0);
+            }
+        } else if (command.type == CommandType::compute) {
+            uint16_t word = 0;
+            if (!encodeCCommand(command, word)) throw translateException(describe(command), command.line);
+            region.words.push_back(word);
+        }
     }
+    return region;
+}
+
+void Assembler::incrementalTranslate() {
+    RegionCache cache;
+    cache.load(cache_path_);
+
+    /* Split at label lines, and find or encode each region. */
+    std::vector<const Region*> layout;
+    std::string_view source = parser_->source();
+    auto addRegion = [&](std::size_t begin, std::size_t end, int first_line) {
+        std::string_view text = source.substr(begin, end - begin);
+        uint64_t hash = RegionCache::hashOf(text);
+        uint32_t length = static_cast<uint32_t>(text.size());
+        const Region* region = cache.find(hash, length);
+        if (region == nullptr) region = &cache.insert(encodeRegion(text, first_line, hash));
+        layout.push_back(region);
+    };
+
+    std::size_t region_begin = 0;
+    int region_line = 1;
+    int line = 1;
+    for (std::size_t position = 0; position < source.size(); ++line) {
+        std::size_t end = source.find('\n', position);
+        if (end == string_end) end = source.size();
+        if (position != region_begin && isLabelLine(source.substr(position, end - position))) {
+            addRegion(region_begin, position, region_line);
+            region_begin = position;
+            region_line = line;
+        }
+        position = end + 1;
+    }
+    if (region_begin < source.size()) addRegion(region_begin, source.size(), region_line);
+
+    /* Lay out labels, then patch symbolic A-Commands in source order(variables in first-use order). */
+    int address = 0;
+    for (const Region* region : layout) {
+        for (const auto& label : region->labels) symbol_table_->addEntry(label.first, address + label.second);
+        address += static_cast<int>(region->words.size());
+    }
+    for (const Region* region : layout) {
+        std::size_t relocation = 0;
+        for (std::size_t i = 0; i < region->words.size(); ++i) {
+            uint16_t word = region->words[i];
+            if (relocation < region->relocations.size() && region->relocations[relocation].first == i) {
+                int id = symbol_table_->findOrInsert(region->relocations[relocation++].second);
+                if (!symbol_table_->isDefined(id)) symbol_table_->addVariable(id);
+                word = code_->address(symbol_table_->addressOf(id));
+            }
+            writeWord(word);
+        }
+    }
+    if (cache.isDirty()) cache.save(cache_path_);
+}
+
+bool Assembler::isStreamVariable(std::string_view symbol) const {
+    /* VMtranslator: statics are <file>.<index>, functions are <file>.<name>, and local labels have '$'. */
+    if (symbol.find('$') != string_end) return false;
+    std::size_t dot = symbol.rfind('.');
+    return dot != string_end && dot + 1 < symbol.size()
+        && std::all_of(symbol.begin() + dot + 1, symbol.end(), [](char c) { return c >= '0' && c <= '9'; });
+}
+
+int Assembler::addFirstUseVariable(int id) {
+    if (first_use_variables_.size() <= static_cast<std::size_t>(id)) first_use_variables_.resize(id + 1, false);
+    first_use_variables_[id] = true;
+    return symbol_table_->addVariable(id);
+}
+
+void Assembler::resolveFixups(std::deque<uint16_t>& window, std::size_t window_begin, bool end) {
+    /* Fixups are in use order, so variables are allocated in first-use order, as in file mode. */
+    while (!fixups_.empty()) {
+        const Fixup& fixup = fixups_.front();
+        int address = 0;
+        if (symbol_table_->isDefined(fixup.symbol)) address = symbol_table_->addressOf(fixup.symbol);
+        else if (end) address = symbol_table_->addVariable(fixup.symbol);
+        else if (isStreamVariable(symbol_table_->name(fixup.symbol))) address = addFirstUseVariable(fixup.symbol);
+        else break;
+        window[fixup.index - window_begin] = code_->address(address);
+        fixups_.pop_front();
+    }
+}
+
+void Assembler::flushWindow(std::deque<uint16_t>& window, std::size_t& window_begin, std::size_t count) {
+    const std::size_t width = static_cast<std::size_t>(wordWidth());
+    std::vector<char> buffer(count * width);
+    for (std::size_t i = 0; i < count; ++i) renderWord(window[i], &buffer[i * width]);
+    /* After an error the image is broken, so nothing more is written. */
+    if (diagnostics_.empty()) stream_->write(buffer.data(), buffer.size());
+    window.erase(window.begin(), window.begin() + count);
+    window_begin += count;
+}
+
+void Assembler::streamTranslate() {
+    const std::size_t CHUNK_SIZE = 64 * 1024;
+    std::vector<char> chunk(CHUNK_SIZE);
+    std::string block;
+    std::deque<uint16_t> window;
+    std::size_t window_begin = 0;
+    int line_base = 0;
+    Parser parser;
+
+    while (*input_) {
+        input_->read(chunk.data(), chunk.size());
+        block.append(chunk.data(), static_cast<std::size_t>(input_->gcount()));
+
+        /* Parse complete lines only. The rest is carried to the next chunk. */
+        std::size_t end = block.rfind('\n');
+        if (end == std::string::npos && *input_) continue;
+        end = (end == std::string::npos || !*input_) ? block.size() : end + 1;
+        std::string_view lines(block.data(), end);
+
+        parser.setSource(lines);
+        while (parser.hasMoreCommands()) {
+            parser.advance();
+            Command command = parser.command();
+            command.line += line_base;
+            if (command.type == CommandType::label) {
+                int id = symbol_table_->findOrInsert(command.symbol);
+                if (static_cast<std::size_t>(id) < first_use_variables_.size() && first_use_variables_[id]) {
+                    diagnostics_.push_back({command.line, "Translate Exception: label was used as a variable before its definition(LABEL: "
+                                                          + std::string(command.symbol) + "(Parse line: " + std::to_string(command.line) + "))."});
+                }
+                symbol_table_->define(id, static_cast<int>(word_count_));
+                continue;
+            }
+            if (command.type != CommandType::address && command.type != CommandType::compute) continue;
+            window.push_back(encodeCommand(command));
+            ++word_count_;
+        }
+        line_base += static_cast<int>(std::count(lines.begin(), lines.end(), '\n'));
+        block.erase(0, end);
+
+        /* Words in front of the first unresolved reference are final. */
+        resolveFixups(window, window_begin, false);
+        std::size_t ready = fixups_.empty() ? word_count_ : fixups_.front().index;
+        flushWindow(window, window_begin, ready - window_begin);
+    }
+    resolveFixups(window, window_begin, true);
+    flushWindow(window, window_begin, window.size());
+    stream_->flush();
+}
+
+void Assembler::discardOutput() {
+    if (output_.is_open()) output_.close();
+    std::remove(temp_path_.c_str());
+    std::remove(hack_path_.c_str());
+    /* A map of an earlier build would point at the wrong lines. */
+    std::remove(map_path_.c_str());
+    temp_path_.clear();
+}
+
+void Assembler::finish() {
+    {
+        PhaseTimer timer(stats_.flush);
+        if (output_.is_open()) output_.close();
+    }
+    /* An invalid command was encoded as 0, so the image is broken. Don't leave it. */
+    if (!temp_path_.empty()) {
+        if (!diagnostics_.empty()) {
+            discardOutput();
+        } else {
+            if (std::rename(temp_path_.c_str(), hack_path_.c_str()) != 0) {
+                std::remove(hack_path_.c_str());
+                if (std::rename(temp_path_.c_str(), hack_path_.c_str()) != 0) throw fileException(hack_path_);
+            }
+            temp_path_.clear();
+        }
+    }
+    stats_.lines = static_cast<std::size_t>(parser_->getFileLine());
+    stats_.variables = (symbol_table_ != nullptr) ? symbol_table_->variableCount() : 0;
+    stats_.bytes = parser_->source().size();
+    stats_.words = word_count_;
+}
+
+bool Assembler::isStaticSymbol(std::string_view symbol) const {
+    /* VMtranslator names static variables <module>.<index> */
+    if (symbol.size() <= module_name_.size() + 1 || symbol.compare(0, module_name_.size(), module_name_) != 0) return false;
+    if (symbol[module_name_.size()] != '.') return false;
+    std::string_view index = symbol.substr(module_name_.size() + 1);
+    return std::all_of(index.begin(), index.end(), [](char c) { return c >= '0' && c <= '9'; });
+}
+
+void Assembler::objectTranslate() {
+    Region region = encodeRegion(parser_->source(), 1, 0);
+
+    ObjectFile object;
+    object.name = module_name_;
+    object.words = std::move(region.words);
+
+    /* Symbol index by name. A label keeps its first definition, same as SymbolTable. */
+    std::unordered_map<std::string, uint32_t> symbols;
+    for (const auto& label : region.labels) {
+        if (symbol_table_->contains(label.first) || symbols.count(label.first) != 0) continue;
+        symbols[label.first] = static_cast<uint32_t>(object.symbols.size());
+        object.symbols.push_back({ObjectSymbolKind::label, label.first, label.second});
+    }
+    for (const auto& relocation : region.relocations) {
+        const std::string& name = relocation.second;
+        if (symbol_table_->contains(name)) {
+            object.words[relocation.first] = code_->address(symbol_table_->GetAddress(name));
+            continue;
+        }
+        auto symbol = symbols.find(name);
+        if (symbol == symbols.end()) {
+            ObjectSymbolKind kind = isStaticSymbol(name) ? ObjectSymbolKind::staticVariable : ObjectSymbolKind::external;
+            symbol = symbols.emplace(name, static_cast<uint32_t>(object.symbols.size())).first;
+            object.symbols.push_back({kind, name, 0});
+        }
+        object.relocations.push_back({relocation.first, symbol->second});
+    }
+    object.save(object_path_);
 }
 
 /* =========== PUBLIC ============= */
 
-Assembler::Assembler(std::string path) {
+Assembler::Assembler(std::string path, const AssemblerOption& option)
+: input_(nullptr), stream_(nullptr), words_(nullptr), word_count_(0), saved_words_(0), option_(option) {
     if (!isASMFile(path)) throw fileException(path);
-    parser_ = new Parser(path);
+    {
+        PhaseTimer timer(stats_.parse);
+        parser_ = new Parser(path);
+    }
     code_ = new Code();
-    symbol_table_= new SymbolTable();
+    symbol_table_ = nullptr;
     path.erase(path.find(".asm"), std::string::npos);
+    std::size_t slash = path.find_last_of("/\\");
+    module_name_ = (slash == string_end) ? path : path.substr(slash + 1);
+    object_path_ = path + ".hobj";
+    map_path_ = path + ".hmap";
     path.append(".hack");
-    output_.open(path);
+    cache_path_ = path + ".cache";
+    if (option_.object) return;
+    /* Words go to a temporary file, which replaces .hack only when translate succeeds. */
+    hack_path_ = path;
+    temp_path_ = path + ".tmp";
+    if (option_.format == OutputFormat::binary) output_.open(temp_path_, std::ios::out | std::ios::binary);
+    else output_.open(temp_path_);
+}
+
+Assembler::Assembler(std::string_view source, std::vector<uint16_t>& words, const AssemblerOption& option)
+: input_(nullptr), stream_(nullptr), words_(&words), word_count_(0), saved_words_(0), option_(option) {
+    parser_ = new Parser();
+    parser_->setSource(source);
+    code_ = new Code();
+    symbol_table_ = nullptr;
+}
+
+Assembler::Assembler(std::istream& input, std::ostream& output, const AssemblerOption& option)
+: input_(&input), stream_(&output), words_(nullptr), word_count_(0), saved_words_(0), option_(option) {
+    option_.single_pass = true;
+    parser_ = new Parser();
+    code_ = new Code();
+    symbol_table_= new SymbolTable();
 }
 
 Assembler::~Assembler() {
     delete parser_;
     delete code_;
     delete symbol_table_;
-    output_.close();
+    /* translate threw(ex. an invalid command of --incremental), so the output is incomplete. */
+    if (!temp_path_.empty()) discardOutput();
 }
 
 void Assembler::translate() {
-    pass1();
-    pass2();
+    if (input_ != nullptr) {
+        streamTranslate();
+        return;
+    }
+    const bool object = option_.object && words_ == nullptr;
+    const bool incremental = option_.incremental && words_ == nullptr;
+    const bool staged = option_.optimize || option_.threads != 1 || option_.map;
+    if (!object && !incremental && !staged) {
+        bool symbol_free = false;
+        {
+            PhaseTimer timer(stats_.encode, &stats_.parse);
+            symbol_free = symbolFreePass();
+        }
+        if (symbol_free) {
+            finish();
+            return;
+        }
+    }
+
+    symbol_table_ = new SymbolTable();
+    if (object) {
+        objectTranslate();
+        return;
+    }
+    if (incremental) {
+        incrementalTranslate();
+        finish();
+        return;
+    }
+    if (staged) {
+        {
+            PhaseTimer timer(stats_.parse);
+            collectCommands();
+        }
+        if (option_.optimize) {
+            PhaseTimer timer(stats_.optimize);
+            optimizeCommands();
+        }
+        {
+            PhaseTimer timer(stats_.labels);
+            defineLabels();
+            allocateVariables();
+        }
+        parallelEncode();
+        if (option_.map && words_ == nullptr && diagnostics_.empty()) source_map_.save(map_path_);
+    } else if (option_.single_pass) {
+        {
+            PhaseTimer timer(stats_.encode, &stats_.parse);
+            singlePass();
+        }
+        PhaseTimer timer(stats_.labels);
+        patchFixups();
+    } else {
+        parser_->resetCursor();
+        {
+            PhaseTimer timer(stats_.labels, &stats_.parse);
+            pass1();
+        }
+        PhaseTimer timer(stats_.encode, &stats_.parse);
+        pass2();
+    }
+    finish();
+}
+
+std::size_t Assembler::savedWords() const {
+    return saved_words_;
+}
+
+const AssemblerStats& Assembler::stats() const {
+    return stats_;
+}
+
+const std::vector<Diagnostic>& Assembler::diagnostics() const {
+    return diagnostics_;
+}
+
+AssembleResult assemble(std::string_view source, const AssemblerOption& option) {
+    AssembleResult result;
+    try {
+        Assembler assembler(source, result.words, option);
+        assembler.translate();
+        result.diagnostics = assembler.diagnostics();
+    } catch (translateException& e) {
+        result.diagnostics.push_back({e.line(), e.what()});
+    } catch (std::exception& e) {
+        result.diagnostics.push_back({0, e.what()});
+    }
+    return result;
 }
\ No newline at end of file
@@ -3,11 +3,58 @@
 
     Function: 
     - constructor:
-        Argument is .asm file path.
+        Argument is .asm file path and option.
         Constructor set file path to parser_,
-        and make new file(.hack).
+        and make new temporary file(.hack.tmp). It replaces .hack when translate succeeds.
+        (In-memory) Argument is .asm source text, word vector and option.
+        Encoded words are appended to the vector, and no file is touched.
+        (Streaming) Argument is input and output stream(ex. std::cin, std::cout) and option.
+    - translate(streaming):
+        Input is read in chunks and assembled in one pass(as option.single_pass).
+        A VMtranslator static(<file>.<index>) is allocated at its first use, once no earlier
+        symbol is pending. Every other undefined symbol is a forward reference: encoded words
+        are kept only from the first unresolved one until its label appears(or the input ends,
+        then it is a variable), and the words in front of it are written as soon as each chunk is done.
+        So the window is bounded by the distance of forward label references, and a variable
+        other than a static keeps the window until the end of input.
+        Variables are allocated in first-use order, so the output is the same as the other modes.
+        (Only a label named like a static, ex. (Main.0), is reported to diagnostics.)
+        Other options(except format) are ignored.
     - translate:
         tranlaste .asm to .hack binary code_ file.
+        Every command is encoded to a 16bit word, and written as text or raw binary(option.format).
+        Symbol-free fast path: commands are encoded in one pass, without symbol table,
+        until the first label or symbolic A-Command. If there is none, translation ends there.
+        Otherwise the words written so far are kept, and the rest is translated as below.
+        If option.single_pass is set, the file is read only once.
+        A symbol which is not defined yet is written as a placeholder,
+        and patched after the last command(labels first, then variables in first-use order).
+        If option.threads isn't 1, translate runs in parallel:
+        1. Collect: read commands once, and define labels.
+        2. Allocate: scan A-Commands in order, and add variables(same address as serial).
+        3. Encode: chunks of commands are encoded by worker threads into one output buffer.
+        4. Write: the buffer is written in order, so the output is same as serial.
+        If option.object is set, a relocatable object(.hobj) is written instead of .hack.
+        Numbers and predefined symbols are encoded, and other symbols are left to Linker.
+        If option.optimize is set, commands(with labels) are collected, rewritten by Optimizer,
+        and labels are defined at their new addresses before encoding.
+        Phases of every path are timed into stats(Stats.h). option.stats only prints them,
+        so they describe the path which really ran.
+        If option.map is set, the staged path is used too, and an address/source map(.hmap, SourceMap.h)
+        is written next to .hack. It has the line, label and VM function of every address after -O.
+        Classification and encoding don't throw. An invalid command is encoded as 0,
+        added to diagnostics, and translation goes on, so every error is reported at once.
+        If there is any diagnostic, the .hack(and .hmap) file is removed at the end.
+        (streaming: words written before the error stay, and nothing is written after it.)
+        (incremental and object stop at the first error, because a region or object must be valid.
+         The error is thrown, and the .hack file is removed too.)
+    - savedWords: number of words removed by Optimizer.
+    - stats: phase times and counters(Stats.h). The output file is closed(flushed) at the end of translate.
+    - diagnostics: errors found by translate, in command order.
+
+    Library interface
+    - assemble(source, option): Assemble source text in memory.
+        Returns encoded words and diagnostics. words is valid only if diagnostics is empty.
 */
 
 #ifndef __ASSEMBLER_H__
@@ -17,26 +64,97 @@
 #include "Parser.h"
 #include "Code.h"
 #include "SymbolTable.h"
+#include "RegionCache.h"
+#include "ObjectFile.h"
+#include "Optimizer.h"
+#include "Stats.h"
+#include "SourceMap.h"
 
 class Assembler {
 private:
+    struct Fixup {
+        std::size_t index;
+        int symbol;
+    };
+
     Parser* parser_;
+    std::istream* input_;
+    std::ostream* stream_;
     Code* code_;
     SymbolTable* symbol_table_;
     std::ofstream output_;
+    std::vector<uint16_t>* words_;
+    std::size_t word_count_;
+    std::size_t saved_words_;
+    AssemblerStats stats_;
+    AssemblerOption option_;
+    std::deque<Fixup> fixups_;
+    std::vector<Diagnostic> diagnostics_;
+    std::vector<bool> first_use_variables_;     // streaming: allocated at first use, by symbol id
+    std::vector<Command> commands_;
+    std::deque<std::string> owned_fields_;
+    std::string cache_path_;
+    std::string object_path_;
+    std::string module_name_;
+    std::string map_path_;
+    std::string hack_path_;
+    std::string temp_path_;                     // empty once the output is renamed or removed
+    SourceMap source_map_;
 
 private:
     bool isASMFile(const std::string path) const;
-    int writePart(SymbolType type);
-    void writeACommand();
-    void writeCCommand();
+    std::string describe(const Command& command) const;
+    uint16_t encodeSymbol(std::string_view symbol);
+    void report(const Command& command);
+    bool isAddress(std::string_view symbol) const;
+    uint16_t encodeACommand(const Command& command);
+    uint16_t encodeCommand(const Command& command);
+    bool encodeResolvedACommand(const Command& command, uint16_t& word) const;
+    bool encodeCCommand(const Command& command, uint16_t& word) const;
+    int wordWidth() const;
+    void renderWord(uint16_t word, char* buffer) const;
+    void writeWord(uint16_t word);
+    void writeWords(const std::vector<uint16_t>& words, const std::vector<char>& rendered, std::size_t count);
+    void advanceParser();
     void pass1();
     void pass2();
+    bool symbolFreePass();
+    void singlePass();
+    void patchFixups();
+    void collectCommands();
+    void optimizeCommands();
+    void defineLabels();
+    void allocateVariables();
+    void parallelEncode();
+    bool isLabelLine(std::string_view line) const;
+    Region encodeRegion(std::string_view text, int first_line, uint64_t hash) const;
+    void incrementalTranslate();
+    bool isStreamVariable(std::string_view symbol) const;
+    int addFirstUseVariable(int id);
+    void resolveFixups(std::deque<uint16_t>& window, std::size_t window_begin, bool end);
+    void flushWindow(std::deque<uint16_t>& window, std::size_t& window_begin, std::size_t count);
+    void streamTranslate();
+    bool isStaticSymbol(std::string_view symbol) const;
+    void objectTranslate();
+    void discardOutput();
+    void finish();
 
 public:
-    Assembler(std::string path);
+    Assembler(std::string path, const AssemblerOption& option = AssemblerOption());
+    Assembler(std::string_view source, std::vector<uint16_t>& words, const AssemblerOption& option = AssemblerOption());
+    Assembler(std::istream& input, std::ostream& output, const AssemblerOption& option = AssemblerOption());
     ~Assembler();
     void translate();
+    std::size_t savedWords() const;
+    const AssemblerStats& stats() const;
+    const std::vector<Diagnostic>& diagnostics() const;
 };
 
+struct AssembleResult {
+    std::vector<uint16_t> words;
+    std::vector<Diagnostic> diagnostics;
+};
+
+AssembleResult assemble(std::string_view source, const AssemblerOption& option = AssemblerOption());
+
 #endif
\ No newline at end of file
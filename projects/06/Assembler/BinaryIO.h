@@ -0,0 +1,69 @@
+/**
+    Binary IO helpers for assembler side files(.hack.cache, .hobj).
+    Integers are little-endian. A string is its length(u32) followed by its bytes.
+
+    Routines
+    - writeInteger(output, value, bytes), writeString(output, text): append to a buffer.
+    - readFile(path, buffer): read whole file. Returns false if it can't be opened.
+    - BinaryReader: read integers and strings from a buffer.
+                    Reading past the end throws std::runtime_error.
+*/
+
+#ifndef __BINARY_IO_H__
+#define __BINARY_IO_H__
+
+#include "Global.h"
+
+inline void writeInteger(std::string& output, uint64_t value, int bytes) {
+    for (int i = 0; i < bytes; ++i) output.push_back(static_cast<char>((value >> (8 * i)) & 0xff));
+}
+
+inline void writeString(std::string& output, std::string_view text) {
+    writeInteger(output, text.size(), 4);
+    output.append(text);
+}
+
+inline bool readFile(const std::string& path, std::string& buffer) {
+    std::ifstream input(path, std::ios::in | std::ios::binary);
+    if (input.fail()) return false;
+    buffer.assign(std::istreambuf_iterator<char>(input), std::istreambuf_iterator<char>());
+    return true;
+}
+
+class BinaryReader {
+private:
+    std::string_view input_;
+    std::size_t cursor_ = 0;
+
+    void require(std::size_t bytes) const {
+        if (input_.size() - cursor_ < bytes) throw std::runtime_error("Unexpected end of file.");
+    }
+
+public:
+    BinaryReader(std::string_view input) : input_(input) { }
+
+    uint64_t readInteger(int bytes) {
+        require(bytes);
+        uint64_t value = 0;
+        for (int i = 0; i < bytes; ++i)
+            value |= static_cast<uint64_t>(static_cast<unsigned char>(input_[cursor_++])) << (8 * i);
+        return value;
+    }
+
+    std::string readString() {
+        std::size_t length = static_cast<std::size_t>(readInteger(4));
+        require(length);
+        std::string text(input_.substr(cursor_, length));
+        cursor_ += length;
+        return text;
+    }
+
+    /* Checks and skips a magic header. */
+    bool expect(std::string_view magic) {
+        if (input_.size() - cursor_ < magic.size() || input_.substr(cursor_, magic.size()) != magic) return false;
+        cursor_ += magic.size();
+        return true;
+    }
+};
+
+#endif
\ No newline at end of file
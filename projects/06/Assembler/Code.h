@@ -6,7 +6,21 @@
     - dest: return dest binary code;
     - comp: return comp binary code;
     - jump: return jump binary code;
-    - canTranslateToBinary
+    - canTranslateToBinary: for address, one scan of the characters(no exception).
+    - isSymbol: true if symbol is a valid label or variable name.
+    - encodeCompute: return a whole C-Command word, or -1 if a mnemonic is unknown.
+    - toText: render 16bit instruction word to "0101..." text.
+
+    Each routine returns the field already shifted to its position in the
+    16bit instruction word, so an instruction is made by OR-ing the fields.
+    A-Command: 0vvv vvvv vvvv vvvv
+    C-Command: 111a cccc ccdd djjj
+
+    Mnemonic tables
+    - A mnemonic has at most 3 characters, so it is packed into one 32bit key.
+    - Each table is a perfect hash(key * multiplier >> shift) built at compile time.
+      The constructor searches a multiplier which has no collision,
+      so a lookup is one multiply and one key compare.
 */
 
 #ifndef __CODE_H__
@@ -14,103 +28,232 @@
 
 #include "Global.h"
 
-class Code {
-private:
-    const std::map<std::string, std::string> DEST = {
-        {"",     "000"},
-        {"M",    "001"},
-        {"D",    "010"},
-        {"MD",   "011"},
-        {"A",    "100"},
-        {"AM",   "101"},
-        {"AD",   "110"},
-        {"AMD",  "111"}
+namespace Mnemonic {
+    constexpr uint32_t INVALID_KEY = 0xffffffff;
+    constexpr uint32_t EMPTY_KEY = 0xfffffffe;
+
+    struct Entry {
+        std::string_view name;
+        uint16_t code;
+    };
+
+    /* Returns INVALID_KEY if the mnemonic is longer than 3 characters. */
+    constexpr uint32_t pack(std::string_view name) {
+        if (name.size() > 3) return INVALID_KEY;
+        uint32_t key = 0;
+        for (std::size_t i = 0; i < name.size(); ++i)
+            key |= static_cast<uint32_t>(static_cast<unsigned char>(name[i])) << (8 * i);
+        return key;
+    }
+
+    template <std::size_t N, int BITS>
+    class PerfectHashTable {
+    private:
+        struct Slot {
+            uint32_t key;
+            uint16_t code;
+        };
+
+        std::array<Slot, (1 << BITS)> slots_;
+        uint32_t multiplier_;
+
+        static constexpr uint32_t slotOf(uint32_t key, uint32_t multiplier) {
+            return (key * multiplier) >> (32 - BITS);
+        }
+
+        static constexpr bool isPerfect(const Entry (&entries)[N], uint32_t multiplier) {
+            bool used[1 << BITS] = {};
+            for (std::size_t i = 0; i < N; ++i) {
+                uint32_t slot = slotOf(pack(entries[i].name), multiplier);
+                if (used[slot]) return false;
+                used[slot] = true;
+            }
+            return true;
+        }
+
+    public:
+        constexpr PerfectHashTable(const Entry (&entries)[N]) : slots_(), multiplier_(0) {
+            uint32_t multiplier = 0x9e3779b1;
+            for (int tries = 0; tries < 100000 && multiplier_ == 0; ++tries) {
+                if (isPerfect(entries, multiplier)) multiplier_ = multiplier;
+                multiplier = (multiplier + 0x3c6ef372) | 1;
+            }
+            if (multiplier_ == 0) throw std::logic_error("No perfect hash multiplier for mnemonic table.");
+
+            for (Slot& slot : slots_) slot = {EMPTY_KEY, 0};
+            for (std::size_t i = 0; i < N; ++i) {
+                uint32_t key = pack(entries[i].name);
+                slots_[slotOf(key, multiplier_)] = {key, entries[i].code};
+            }
+        }
+
+        /* Returns -1 if the mnemonic isn't in the table. */
+        constexpr int find(std::string_view name) const {
+            uint32_t key = pack(name);
+            const Slot& slot = slots_[slotOf(key, multiplier_)];
+            return (slot.key == key) ? slot.code : -1;
+        }
+    };
+
+    constexpr Entry DEST[] = {
+        {"",     0b000},
+        {"M",    0b001},
+        {"D",    0b010},
+        {"MD",   0b011},
+        {"A",    0b100},
+        {"AM",   0b101},
+        {"AD",   0b110},
+        {"AMD",  0b111}
     };
 
-    const std::map<std::string, std::string> COMP = {
-        {"0",    "0101010"},
-        {"1",    "0111111"},
-        {"-1",   "0111010"},
-        {"D",    "0001100"},
-        {"A",    "0110000"},
-        {"M",    "1110000"},
-        {"!D",   "0001101"},
-        {"!A",   "0110001"},
-        {"!M",   "1110001"},
-        {"-D",   "0001111"},
-        {"-A",   "0110011"},
-        {"-M",   "1110011"},
-        {"D+1",  "0011111"},
-        {"A+1",  "0110111"},
-        {"M+1",  "1110111"},
-        {"D-1",  "0001110"},
-        {"A-1",  "0110010"},
-        {"M-1",  "1110010"},
-        {"D+A",  "0000010"},
-        {"D+M",  "1000010"},
-        {"D-A",  "0010011"},
-        {"D-M",  "1010011"},
-        {"A-D",  "0000111"},
-        {"M-D",  "1000111"},
-        {"D&A",  "0000000"},
-        {"D&M",  "1000000"},
-        {"D|A",  "0010101"},
-        {"D|M",  "1010101"}
+    constexpr Entry COMP[] = {
+        {"0",    0b0101010},
+        {"1",    0b0111111},
+        {"-1",   0b0111010},
+        {"D",    0b0001100},
+        {"A",    0b0110000},
+        {"M",    0b1110000},
+        {"!D",   0b0001101},
+        {"!A",   0b0110001},
+        {"!M",   0b1110001},
+        {"-D",   0b0001111},
+        {"-A",   0b0110011},
+        {"-M",   0b1110011},
+        {"D+1",  0b0011111},
+        {"A+1",  0b0110111},
+        {"M+1",  0b1110111},
+        {"D-1",  0b0001110},
+        {"A-1",  0b0110010},
+        {"M-1",  0b1110010},
+        {"D+A",  0b0000010},
+        {"D+M",  0b1000010},
+        {"D-A",  0b0010011},
+        {"D-M",  0b1010011},
+        {"A-D",  0b0000111},
+        {"M-D",  0b1000111},
+        {"D&A",  0b0000000},
+        {"D&M",  0b1000000},
+        {"D|A",  0b0010101},
+        {"D|M",  0b1010101},
+        /* Commutative forms, accepted by the nand2tetris tools and written by VMtranslator */
+        {"A+D",  0b0000010},
+        {"M+D",  0b1000010},
+        {"A&D",  0b0000000},
+        {"M&D",  0b1000000},
+        {"A|D",  0b0010101},
+        {"M|D",  0b1010101}
     };
 
-    const std::map<std::string, std::string> JUMP = {
-        {"",     "000"},
-        {"JGT",  "001"},
-        {"JEQ",  "010"},
-        {"JGE",  "011"},
-        {"JLT",  "100"},
-        {"JNE",  "101"},
-        {"JLE",  "110"},
-        {"JMP",  "111"}
+    constexpr Entry JUMP[] = {
+        {"",     0b000},
+        {"JGT",  0b001},
+        {"JEQ",  0b010},
+        {"JGE",  0b011},
+        {"JLT",  0b100},
+        {"JNE",  0b101},
+        {"JLE",  0b110},
+        {"JMP",  0b111}
     };
 
+    constexpr PerfectHashTable<std::size(DEST), 4> DEST_TABLE(DEST);
+    constexpr PerfectHashTable<std::size(COMP), 6> COMP_TABLE(COMP);
+    constexpr PerfectHashTable<std::size(JUMP), 4> JUMP_TABLE(JUMP);
+}
+
+class Code {
+private:
+    static int lookup(std::string_view symbol, SymbolType type) {
+        if (type == SymbolType::dest) return Mnemonic::DEST_TABLE.find(symbol);
+        if (type == SymbolType::comp) return Mnemonic::COMP_TABLE.find(symbol);
+        if (type == SymbolType::jump) return Mnemonic::JUMP_TABLE.find(symbol);
+        return -1;
+    }
+
+    static bool isDigit(char c) {
+        return c >= '0' && c <= '9';
+    }
+
+    /* One scan: an optional sign followed by digits only, and it must fit in int. */
+    static bool parseDecimal(std::string_view symbol, int& value) {
+        bool negative = !symbol.empty() && symbol[0] == '-';
+        if (!symbol.empty() && (symbol[0] == '+' || symbol[0] == '-')) symbol.remove_prefix(1);
+        if (symbol.empty()) return false;
+        int64_t result = 0;
+        for (char c : symbol) {
+            if (!isDigit(c)) return false;
+            result = result * 10 + (c - '0');
+            if (result > 0x7fffffff) return false;
+        }
+        value = static_cast<int>(negative ? -result : result);
+        return true;
+    }
+
+    static uint16_t at(std::string_view symbol, SymbolType type) {
+        int code = lookup(symbol, type);
+        if (code < 0) throw std::out_of_range("Unknown mnemonic: " + std::string(symbol));
+        return static_cast<uint16_t>(code);
+    }
+
 public:
     Code() { }
     ~Code() { }
 
-    std::string address(const std::string& symbol) const {
-        std::bitset<15> result(std::stoi(symbol));
-        return result.to_string();
+    uint16_t address(std::string_view symbol) const {
+        int value = 0;
+        if (!parseDecimal(symbol, value)) throw std::invalid_argument("Not a decimal address: " + std::string(symbol));
+        return address(value);
     }
 
-    std::string address(const int& symbol) const {
-        std::bitset<15> result(symbol);
-        return result.to_string();
+    uint16_t address(const int& symbol) const {
+        return static_cast<uint16_t>(symbol & 0x7fff);
     }
 
-    std::string dest(const std::string& symbol) const {
-        std::bitset<3> result(DEST.at(symbol));
-        return result.to_string();
+    uint16_t dest(std::string_view symbol) const {
+        return static_cast<uint16_t>(at(symbol, SymbolType::dest) << 3);
     }
-    
-    std::string comp(const std::string& symbol) const {
-        std::bitset<7> result(COMP.at(symbol));
-        return result.to_string();
+
+    uint16_t comp(std::string_view symbol) const {
+        return static_cast<uint16_t>(at(symbol, SymbolType::comp) << 6);
+    }
+
+    uint16_t jump(std::string_view symbol) const {
+        return at(symbol, SymbolType::jump);
     }
 
-    std::string jump(const std::string& symbol) const {
-        std::bitset<3> result(JUMP.at(symbol));
-        return result.to_string();
+    static uint16_t compute() {
+        return 0xe000;
+    }
+
+    /* text must have at least 16 characters. */
+    static void toText(uint16_t word, char* text) {
+        for (int bit = 15; bit >= 0; --bit) {
+            *text++ = static_cast<char>('0' + ((word >> bit) & 1));
+        }
     }
 
-    bool canTranslateToBinary(const std::string& symbol, SymbolType type) const {
+    /* Returns -1 if a mnemonic is unknown. No exception is thrown. */
+    int encodeCompute(std::string_view dest, std::string_view comp, std::string_view jump) const {
+        int d = lookup(dest, SymbolType::dest);
+        int c = lookup(comp, SymbolType::comp);
+        int j = lookup(jump, SymbolType::jump);
+        if (d < 0 || c < 0 || j < 0) return -1;
+        return compute() | (c << 6) | (d << 3) | j;
+    }
+
+    /* A symbol starts with a letter, '_', '.', '$' or ':', and has digits too after that. */
+    static bool isSymbol(std::string_view symbol) {
+        if (symbol.empty() || isDigit(symbol[0])) return false;
+        return std::all_of(symbol.begin(), symbol.end(), [](char c) {
+            return isDigit(c) || (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || c == '_' || c == '.' || c == '$' || c == ':';
+        });
+    }
+
+    bool canTranslateToBinary(std::string_view symbol, SymbolType type) const {
         if (type == SymbolType::address) {
-            try {
-                std::stoi(symbol);
-                return true;
-            } catch(std::exception& e) {
-                return false;
-            }
+            int value = 0;
+            return parseDecimal(symbol, value);
         }
-        else if (type == SymbolType::dest)  return (DEST.find(symbol) != DEST.end());
-        else if (type == SymbolType::comp)  return (COMP.find(symbol) != COMP.end());
-        else if (type == SymbolType::jump)  return (JUMP.find(symbol) != JUMP.end());
-        return false;
+        return lookup(symbol, type) >= 0;
     }
 };
 
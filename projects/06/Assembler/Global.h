@@ -9,11 +9,54 @@
 #include <fstream>
 #include <exception>
 #include <string>
-#include <bitset>
+#include <cstdint>
 #include <map>
+#include <unordered_map>
+#include <vector>
+#include <array>
+#include <string_view>
+#include <stdexcept>
+#include <algorithm>
+#include <charconv>
+#include <deque>
+#include <memory>
+#include <thread>
+#include <atomic>
+#include <cstdio>
 
 enum class CommandType { nothing = 0, address = 1, compute = 2, label = 3 };
 enum class SymbolType { nothing = 0, address = 1, dest = 2, comp = 3, jump = 4, label = 5 };
+enum class OutputFormat { text = 0, binary = 1 };
+enum class StatsFormat { none = 0, text = 1, json = 2 };
+
+/**
+    Assembler Option
+    - single_pass: Translate in one pass. Forward label references are
+                   written as placeholders and patched at the end of input.
+    - format: text writes a "0101..." line per instruction,
+              binary writes each instruction as a raw little-endian 16bit word.
+    - threads: If it isn't 1, commands are collected in one read, and encoded by worker threads.
+               0 means the number of hardware threads.
+    - incremental: Keep encoded regions in a cache file(.hack.cache) next to the output,
+                   and encode only regions which changed since the last run.
+    - object: Write a relocatable object(.hobj) instead of .hack. Symbols are resolved by the linker.
+    - optimize: Run peephole rewrites(Optimizer.h) between parsing and encoding.
+                It is ignored by incremental and object.
+    - stats: Time each phase and count commands(Stats.h), and print them as text or JSON.
+             It is ignored by incremental, object and streaming.
+    - map: Write an address/source map(.hmap) for profilers and emulators.
+           It is ignored by incremental, object and streaming.
+*/
+struct AssemblerOption {
+    bool single_pass = false;
+    OutputFormat format = OutputFormat::text;
+    int threads = 1;
+    bool incremental = false;
+    bool object = false;
+    bool optimize = false;
+    StatsFormat stats = StatsFormat::none;
+    bool map = false;
+};
 
 class fileException : public std::runtime_error {
 public:
@@ -28,9 +71,29 @@ public:
 };
 
 class translateException : public std::runtime_error {
+private:
+    int line_;
+
 public:
-    translateException(const std::string& command)
-    : runtime_error("Translate Exception: fail to translate command(" + command + ").") { }
+    translateException(const std::string& command, int line = 0)
+    : runtime_error("Translate Exception: fail to translate command(" + command + ")."), line_(line) { }
+
+    int line() const { return line_; }
+};
+
+class linkException : public std::runtime_error {
+public:
+    linkException(const std::string& message)
+    : runtime_error("Link Exception: " + message + ".") { }
+};
+
+/**
+    Diagnostic
+    An error found while assembling. line is the .asm file line(0 if unknown).
+*/
+struct Diagnostic {
+    int line;
+    std::string message;
 };
 
 #endif
\ No newline at end of file
@@ -0,0 +1,76 @@
+/**
+    Implementation of Linker.h
+*/
+
+#include "Linker.h"
+
+/* =========== PRIVATE ============= */
+
+void Linker::loadObjects() {
+    objects_.resize(object_paths_.size());
+    for (std::size_t i = 0; i < object_paths_.size(); ++i) objects_[i].load(object_paths_[i]);
+}
+
+void Linker::defineLabels() {
+    /* Label owner module, to report a duplicate definition. */
+    std::unordered_map<std::string_view, const ObjectFile*> owners;
+    std::size_t base = 0;
+    for (const ObjectFile& object : objects_) {
+        for (const ObjectSymbol& symbol : object.symbols) {
+            if (symbol.kind != ObjectSymbolKind::label) continue;
+            auto owner = owners.emplace(symbol.name, &object);
+            if (!owner.second)
+                throw linkException("label(" + symbol.name + ") is defined in " + owner.first->second->name + " and " + object.name);
+            symbol_table_.addEntry(symbol.name, static_cast<int>(base + symbol.offset));
+        }
+        base += object.words.size();
+    }
+}
+
+void Linker::relocate() {
+    for (ObjectFile& object : objects_) {
+        /* Relocations are in word order, so variables are allocated in first-use order. */
+        std::vector<int> ids(object.symbols.size(), SymbolTable::NOT_FOUND);
+        for (const Relocation& relocation : object.relocations) {
+            int& id = ids[relocation.symbol];
+            if (id == SymbolTable::NOT_FOUND) id = symbol_table_.findOrInsert(object.symbols[relocation.symbol].name);
+            if (!symbol_table_.isDefined(id)) symbol_table_.addVariable(id);
+            object.words[relocation.offset] = code_.address(symbol_table_.addressOf(id));
+        }
+    }
+}
+
+void Linker::write() const {
+    std::ofstream output;
+    if (option_.format == OutputFormat::binary) output.open(output_path_, std::ios::out | std::ios::binary);
+    else output.open(output_path_);
+    if (output.fail()) throw fileException(output_path_);
+
+    std::string buffer;
+    for (const ObjectFile& object : objects_) {
+        for (uint16_t word : object.words) {
+            if (option_.format == OutputFormat::binary) {
+                buffer.push_back(static_cast<char>(word & 0xff));
+                buffer.push_back(static_cast<char>(word >> 8));
+            } else {
+                char text[16];
+                Code::toText(word, text);
+                buffer.append(text, 16);
+                buffer.push_back('\n');
+            }
+        }
+    }
+    output.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+}
+
+/* =========== PUBLIC ============= */
+
+Linker::Linker(const std::vector<std::string>& object_paths, const std::string& output_path, const AssemblerOption& option)
+: object_paths_(object_paths), output_path_(output_path), option_(option) { }
+
+void Linker::link() {
+    loadObjects();
+    defineLabels();
+    relocate();
+    write();
+}
\ No newline at end of file
@@ -0,0 +1,48 @@
+/**
+    Linker Module(Class)
+    Links relocatable objects(.hobj) into one .hack file.
+
+    Process
+    1. Load: objects are placed in the given order. A module starts at the
+       total word count of the modules before it.
+    2. Labels: every label is defined at its module base + offset.
+       A label defined by two modules is an error.
+    3. Relocate: relocations are patched in program order. A symbol which isn't
+       a label becomes a variable(from address 16, in first-use order),
+       so the output is same as assembling the concatenated sources.
+    4. Write: as text or raw binary(option.format), same as Assembler.
+
+    How to use
+    Linker linker(objectPaths, outputPath, option);
+    linker.link();
+*/
+
+#ifndef __LINKER_H__
+#define __LINKER_H__
+
+#include "Global.h"
+#include "Code.h"
+#include "SymbolTable.h"
+#include "ObjectFile.h"
+
+class Linker {
+private:
+    std::vector<std::string> object_paths_;
+    std::string output_path_;
+    AssemblerOption option_;
+    std::vector<ObjectFile> objects_;
+    SymbolTable symbol_table_;
+    Code code_;
+
+private:
+    void loadObjects();
+    void defineLabels();
+    void relocate();
+    void write() const;
+
+public:
+    Linker(const std::vector<std::string>& object_paths, const std::string& output_path, const AssemblerOption& option = AssemblerOption());
+    void link();
+};
+
+#endif
\ No newline at end of file
@@ -0,0 +1,65 @@
+/**
+    Implementation of ObjectFile.h
+*/
+
+#include "ObjectFile.h"
+#include "BinaryIO.h"
+
+namespace {
+    const std::string_view MAGIC = "HACKOBJ1";
+}
+
+/* =========== PUBLIC ============= */
+
+void ObjectFile::load(const std::string& path) {
+    std::string buffer;
+    if (!readFile(path, buffer)) throw fileException(path);
+
+    try {
+        BinaryReader reader(buffer);
+        if (!reader.expect(MAGIC)) throw fileException(path);
+        name = reader.readString();
+        words.resize(static_cast<std::size_t>(reader.readInteger(4)));
+        for (uint16_t& word : words) word = static_cast<uint16_t>(reader.readInteger(2));
+        symbols.resize(static_cast<std::size_t>(reader.readInteger(4)));
+        for (ObjectSymbol& symbol : symbols) {
+            uint64_t kind = reader.readInteger(1);
+            if (kind > static_cast<uint64_t>(ObjectSymbolKind::external)) throw fileException(path);
+            symbol.kind = static_cast<ObjectSymbolKind>(kind);
+            symbol.name = reader.readString();
+            symbol.offset = static_cast<uint32_t>(reader.readInteger(4));
+        }
+        relocations.resize(static_cast<std::size_t>(reader.readInteger(4)));
+        for (Relocation& relocation : relocations) {
+            relocation.offset = static_cast<uint32_t>(reader.readInteger(4));
+            relocation.symbol = static_cast<uint32_t>(reader.readInteger(4));
+            if (relocation.offset >= words.size() || relocation.symbol >= symbols.size()) throw fileException(path);
+        }
+    } catch (fileException& e) {
+        throw e;
+    } catch (std::exception& e) {
+        throw fileException(path);
+    }
+}
+
+void ObjectFile::save(const std::string& path) const {
+    std::string buffer(MAGIC);
+    writeString(buffer, name);
+    writeInteger(buffer, words.size(), 4);
+    for (uint16_t word : words) writeInteger(buffer, word, 2);
+    writeInteger(buffer, symbols.size(), 4);
+    for (const ObjectSymbol& symbol : symbols) {
+        writeInteger(buffer, static_cast<uint64_t>(symbol.kind), 1);
+        writeString(buffer, symbol.name);
+        writeInteger(buffer, symbol.offset, 4);
+    }
+    writeInteger(buffer, relocations.size(), 4);
+    for (const Relocation& relocation : relocations) {
+        writeInteger(buffer, relocation.offset, 4);
+        writeInteger(buffer, relocation.symbol, 4);
+    }
+
+    std::ofstream output(path, std::ios::out | std::ios::binary);
+    if (output.fail()) throw fileException(path);
+    output.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+}
\ No newline at end of file
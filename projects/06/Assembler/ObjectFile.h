@@ -0,0 +1,54 @@
+/**
+    ObjectFile Module
+    Relocatable object(.hobj) of one separately assembled .asm file.
+
+    Sections
+    - code: encoded words. A word with a relocation is left as 0.
+    - symbols: every symbol used or defined in the module.
+        label: defined in this module at 'offset'(relative to the module start).
+        static: VMtranslator static variable of this module(<module>.<number>).
+                It is always a variable, allocated by the linker.
+        external: not defined in this module. The linker resolves it to a label
+                  of another module, or allocates it as a variable.
+    - relocations: (word offset, symbol index) for every symbolic A-Command.
+    Predefined symbols(SP, R0~R15, SCREEN, KBD, ...) and numbers are encoded directly.
+
+    File(little-endian, see BinaryIO.h)
+    "HACKOBJ1", module name,
+    word count(u32), { word(u16) }
+    symbol count(u32), { kind(u8), name, offset(u32) }
+    relocation count(u32), { offset(u32), symbol index(u32) }
+
+    Routines
+    - load(path), save(path)
+*/
+
+#ifndef __OBJECT_FILE_H__
+#define __OBJECT_FILE_H__
+
+#include "Global.h"
+
+enum class ObjectSymbolKind { label = 0, staticVariable = 1, external = 2 };
+
+struct ObjectSymbol {
+    ObjectSymbolKind kind;
+    std::string name;
+    uint32_t offset;
+};
+
+struct Relocation {
+    uint32_t offset;
+    uint32_t symbol;
+};
+
+struct ObjectFile {
+    std::string name;
+    std::vector<uint16_t> words;
+    std::vector<ObjectSymbol> symbols;
+    std::vector<Relocation> relocations;
+
+    void load(const std::string& path);
+    void save(const std::string& path) const;
+};
+
+#endif
\ No newline at end of file
@@ -0,0 +1,126 @@
+/**
+    Implementation of Optimizer.h
+*/
+
+#include "Optimizer.h"
+
+namespace {
+    /* dest without M. Only valid dest mnemonics are folded. */
+    bool withoutM(std::string_view dest, std::string_view& result) {
+        if (dest == "M") result = "";
+        else if (dest == "AM") result = "A";
+        else if (dest == "MD") result = "D";
+        else if (dest == "AMD") result = "AD";
+        else return false;
+        return true;
+    }
+}
+
+/* =========== PRIVATE ============= */
+
+bool Optimizer::isInstruction(const Command& command) const {
+    return command.type == CommandType::address || command.type == CommandType::compute;
+}
+
+bool Optimizer::writesA(const Command& command) const {
+    return command.dest.find('A') != string_end;
+}
+
+bool Optimizer::isUnconditionalJump(const Command& command) const {
+    return command.type == CommandType::compute && command.jump == "JMP";
+}
+
+/* Returns the index of the last instruction in output_(labels are skipped), or -1. */
+int Optimizer::lastInstruction() const {
+    for (int i = static_cast<int>(output_.size()) - 1; i >= 0; --i) {
+        if (isInstruction(output_[i])) return i;
+    }
+    return -1;
+}
+
+bool Optimizer::removeDeadLoad() {
+    int last = lastInstruction();
+    if (last < 0 || output_[last].type != CommandType::address) return false;
+    output_.erase(output_.begin() + last);
+    return true;
+}
+
+bool Optimizer::isRedundantReload(const Command& command) const {
+    std::size_t size = output_.size();
+    if (size < 2) return false;
+    const Command& load = output_[size - 2];
+    const Command& compute = output_[size - 1];
+    return load.type == CommandType::address && load.symbol == command.symbol
+        && compute.type == CommandType::compute && !writesA(compute);
+}
+
+bool Optimizer::foldIncrementPair(const Command& command) {
+    if (output_.empty()) return false;
+    const Command& first = output_.back();
+    if (first.type != CommandType::compute || first.dest != "M" || !first.jump.empty()) return false;
+    bool inverse = (first.comp == "M-1" && command.comp == "M+1") || (first.comp == "M+1" && command.comp == "M-1");
+    std::string_view dest;
+    if (!inverse || !withoutM(command.dest, dest)) return false;
+
+    output_.pop_back();
+    if (!dest.empty() || !command.jump.empty())
+        output_.push_back({CommandType::compute, "", dest, "M", command.jump, command.line});
+    return true;
+}
+
+bool Optimizer::rewrite(std::vector<Command>& commands) {
+    bool changed = false;
+    bool unreachable = false;
+    output_.clear();
+    output_.reserve(commands.size());
+    for (const Command& command : commands) {
+        if (command.type == CommandType::label) {
+            unreachable = false;
+            output_.push_back(command);
+            continue;
+        }
+        if (!isInstruction(command)) continue;
+        if (unreachable) {
+            changed = true;
+            continue;
+        }
+
+        if (command.type == CommandType::address) {
+            if (isRedundantReload(command)) {
+                changed = true;
+                continue;
+            }
+            changed |= removeDeadLoad();
+        } else if (foldIncrementPair(command)) {
+            changed = true;
+            continue;
+        }
+        output_.push_back(command);
+        unreachable = isUnconditionalJump(command);
+    }
+    commands.swap(output_);
+    return changed;
+}
+
+bool Optimizer::jumpsToNumber(const std::vector<Command>& commands) const {
+    for (std::size_t i = 1; i < commands.size(); ++i) {
+        const Command& load = commands[i - 1];
+        if (load.type != CommandType::address || commands[i].type != CommandType::compute || commands[i].jump.empty()) continue;
+        if (!load.symbol.empty() && load.symbol[0] >= '0' && load.symbol[0] <= '9') return true;
+    }
+    return false;
+}
+
+/* =========== PUBLIC ============= */
+
+std::size_t Optimizer::optimize(std::vector<Command>& commands) {
+    if (jumpsToNumber(commands)) return 0;
+
+    auto countWords = [this](const std::vector<Command>& list) {
+        return static_cast<std::size_t>(std::count_if(list.begin(), list.end(), [this](const Command& command) { return isInstruction(command); }));
+    };
+
+    std::size_t before = countWords(commands);
+    while (rewrite(commands)) { }
+    return before - countWords(commands);
+}
@@ -0,0 +1,53 @@
+/**
+    Optimizer Module(Class)
+    Peephole optimizer over parsed commands(-O).
+
+    Rewrites
+    - Dead load: an A-Command followed by another A-Command(labels between are allowed)
+      is removed, because A is overwritten before it is read.
+    - Redundant reload: "@X, C, @X" where C doesn't write A. The second @X is removed.
+    - Increment pair: "M=M-1" followed by "dest=M+1"(or M+1 then M-1) where dest has M.
+      M is restored, so the pair becomes "dest'=M"(dest without M), or nothing.
+    - Unreachable code: commands after an unconditional jump(;JMP) until the next label.
+    The rules are applied again until nothing changes.
+    A rewrite never spans a label, except a dead load, which is dead on every path.
+
+    Caution
+    - Label addresses change, so jumps must target labels, not numbers.
+      A program with "@number" in front of a jump is left unchanged(test/NumericJump.asm).
+    - A code address which reaches a jump indirectly is not detected. In
+      "@100, D=A, @R13, M=D ... @R13, A=M, 0;JMP" the 100 isn't moved with the code,
+      so such a program must not be assembled with -O. Store "@LABEL" instead of a number
+      (as VMtranslator does for return addresses).
+
+    Routines
+    - optimize(commands): rewrite commands(labels included) in place,
+                          and return the number of words saved.
+*/
+
+#ifndef __OPTIMIZER_H__
+#define __OPTIMIZER_H__
+
+#include "Global.h"
+#include "Parser.h"
+
+class Optimizer {
+private:
+    std::vector<Command> output_;
+
+private:
+    bool isInstruction(const Command& command) const;
+    bool writesA(const Command& command) const;
+    bool isUnconditionalJump(const Command& command) const;
+    int lastInstruction() const;
+    bool removeDeadLoad();
+    bool isRedundantReload(const Command& command) const;
+    bool foldIncrementPair(const Command& command);
+    bool jumpsToNumber(const std::vector<Command>& commands) const;
+    bool rewrite(std::vector<Command>& commands);
+
+public:
+    std::size_t optimize(std::vector<Command>& commands);
+};
+
+#endif
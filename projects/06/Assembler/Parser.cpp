@@ -4,45 +4,97 @@
 
 #include "Parser.h"
 
+#if defined(_WIN32)
+#include <sstream>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
 /* =========== PRIVATE ============= */
 
+void Parser::load(const std::string& path) {
+    mapped_ = nullptr;
+    mapped_size_ = 0;
+#if defined(_WIN32)
+    std::ifstream input(path, std::ios::in | std::ios::binary);
+    if (input.fail()) throw fileException(path);
+    std::ostringstream buffer;
+    buffer << input.rdbuf();
+    fallback_ = buffer.str();
+    source_ = fallback_;
+#else
+    int fd = open(path.c_str(), O_RDONLY);
+    if (fd < 0) throw fileException(path);
+    struct stat status;
+    if (fstat(fd, &status) < 0) {
+        close(fd);
+        throw fileException(path);
+    }
+    mapped_size_ = static_cast<std::size_t>(status.st_size);
+    if (mapped_size_ > 0) {
+        mapped_ = mmap(nullptr, mapped_size_, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (mapped_ == MAP_FAILED) {
+            mapped_ = nullptr;
+            close(fd);
+            throw fileException(path);
+        }
+        madvise(mapped_, mapped_size_, MADV_SEQUENTIAL);
+        source_ = std::string_view(static_cast<const char*>(mapped_), mapped_size_);
+    }
+    close(fd);
+#endif
+}
+
 void Parser::initializer() {
+    cursor_ = 0;
     current_command_file_line_ = 0;
     file_line_ = 0;
     command_address_ = -1;
+    next_scratch_ = 0;
     current_command_ = "";
     next_command_ = readCommand();
     checkCommandType(current_command_);
 }
 
-std::string Parser::readCommand() {
-    std::string buffer = "";
-    while (!input_.eof()) {
+std::string_view Parser::readCommand() {
+    std::string_view buffer = "";
+    while (cursor_ < source_.size()) {
         ++file_line_;
-        std::getline(input_, buffer);
+        string_iter end = source_.find('\n', cursor_);
+        if (end == string_end) end = source_.size();
+        buffer = source_.substr(cursor_, end - cursor_);
+        cursor_ = end + 1;
         deleteComment(buffer);
-        deleteWhiteSpace(buffer);
+        buffer = deleteWhiteSpace(buffer, scratch_[next_scratch_]);
         if (!isEmptyCommand(buffer)) return buffer;
     }
     return buffer;
 }
 
-void Parser::deleteComment(std::string& command) {
+void Parser::deleteComment(std::string_view& command) const {
     string_iter pos = command.find("//");
-    if (pos != string_end) command.erase(pos, string_end);
+    if (pos != string_end) command.remove_suffix(command.size() - pos);
 }
 
-void Parser::deleteWhiteSpace(std::string& command) {
-    int idx = 0;
-    while (idx < static_cast<int>(command.size())) {
-        if (command[idx] == ' ' || command[idx] == '\t') {
-            command.erase(idx--, 1);
-        }
-        ++idx;
+std::string_view Parser::deleteWhiteSpace(std::string_view command, std::string& scratch) const {
+    const char* white_space = " \t\r";
+    string_iter begin = command.find_first_not_of(white_space);
+    if (begin == string_end) return "";
+    string_iter end = command.find_last_not_of(white_space);
+    command = command.substr(begin, end - begin + 1);
+    if (command.find_first_of(white_space) == string_end) return command;
+
+    scratch.clear();
+    for (char c : command) {
+        if (c != ' ' && c != '\t' && c != '\r') scratch.push_back(c);
     }
+    return scratch;
 }
 
-void Parser::checkCommandType(const std::string& command) {
+void Parser::checkCommandType(std::string_view command) {
     if (isEmptyCommand(command)) {
         type_ = CommandType::nothing;
     } else if (command[0] == '@') {
@@ -54,30 +106,45 @@ void Parser::checkCommandType(const std::string& command) {
     }
 }
 
-bool Parser::isEmptyCommand(const std::string& command) const {
-    return (static_cast<int>(command.size()) == 0);
+bool Parser::isEmptyCommand(std::string_view command) const {
+    return command.empty();
 }
 
 /* =========== PUBLIC ============= */
 
+Parser::Parser() : mapped_(nullptr), mapped_size_(0) {
+    initializer();
+}
+
 Parser::Parser(std::string path) {
-    input_.open(path);
-    if (input_.fail()) throw fileException(path);
+    load(path);
     initializer();
 }
 
+void Parser::setSource(std::string_view source) {
+    source_ = source;
+    initializer();
+}
+
+std::string_view Parser::source() const {
+    return source_;
+}
+
 bool Parser::hasMoreCommands() const {
     if (isEmptyCommand(next_command_)) return false;
     else return true;
 }
 
 Parser::~Parser() {
-    input_.close();
+#if !defined(_WIN32)
+    if (mapped_ != nullptr) munmap(mapped_, mapped_size_);
+#endif
 }
 
 void Parser::advance() {
     current_command_file_line_ = file_line_;
     current_command_ = next_command_;
+    next_scratch_ = 1 - next_scratch_;
     next_command_ = readCommand();
     checkCommandType(current_command_);
 
@@ -89,48 +156,59 @@ CommandType Parser::commandType() const {
     return type_;
 }
 
-std::string Parser::symbol() const {
+std::string_view Parser::symbol() const {
     if (type_ != CommandType::address && type_ != CommandType::label)
         throw functionCallException("This command isn't A-COMMAND or label(Parse line: " + std::to_string(current_command_file_line_) + ")");
-    std::string result = current_command_.substr(1, string_end);
-    if (result.back() == ')') result.pop_back();
+    std::string_view result = current_command_.substr(1, string_end);
+    if (!result.empty() && result.back() == ')') result.remove_suffix(1);
     return result;
 }
 
-std::string Parser::dest() const {
+std::string_view Parser::dest() const {
     if (type_ != CommandType::compute)
         throw functionCallException("This command isn't C-COMMAND(Parse line: " + std::to_string(current_command_file_line_) + ")");
-    string_iter destPos = current_command_.find("=");
-    std::string result = "";
-    if (destPos == string_end) return result;
-    result = current_command_.substr(0, destPos);
-    return result;
+    string_iter destPos = current_command_.find('=');
+    if (destPos == string_end) return "";
+    return current_command_.substr(0, destPos);
 }
 
-std::string Parser::comp() const {
+std::string_view Parser::comp() const {
     if (type_ != CommandType::compute)
         throw functionCallException("This command isn't C-COMMAND(Parse line: " + std::to_string(current_command_file_line_) + ")");
-    string_iter destPos = current_command_.find("=");
-    string_iter jumpPos = current_command_.find(";");
-    std::string result = current_command_;
-    if (jumpPos != string_end) result.erase(jumpPos, string_end);
-    if (destPos != string_end) result.erase(0, destPos+1);
+    string_iter destPos = current_command_.find('=');
+    string_iter jumpPos = current_command_.find(';');
+    std::string_view result = current_command_;
+    if (jumpPos != string_end) result.remove_suffix(result.size() - jumpPos);
+    if (destPos != string_end) result.remove_prefix(std::min(destPos+1, result.size()));
     return result;
 }
 
-std::string Parser::jump() const {
+std::string_view Parser::jump() const {
     if (type_ != CommandType::compute)
         throw functionCallException("This command isn't C-COMMAND(Parse line: " + std::to_string(current_command_file_line_) + ")");
-    string_iter jumpPos = current_command_.find(";");
-    std::string result = "";
-    if (jumpPos == string_end) return result;
-    result = current_command_.substr(jumpPos+1, string_end);
+    string_iter jumpPos = current_command_.find(';');
+    if (jumpPos == string_end) return "";
+    return current_command_.substr(jumpPos+1, string_end);
+}
+
+Command Parser::command() const {
+    Command result = {type_, "", "", "", "", current_command_file_line_};
+    if (type_ == CommandType::address || type_ == CommandType::label) {
+        result.symbol = symbol();
+    } else if (type_ == CommandType::compute) {
+        result.dest = dest();
+        result.comp = comp();
+        result.jump = jump();
+    }
     return result;
 }
 
+bool Parser::isMappedCommand() const {
+    const char* begin = source_.data();
+    return begin != nullptr && current_command_.data() >= begin && current_command_.data() < begin + source_.size();
+}
+
 void Parser::resetCursor() {
-    input_.clear();
-    input_.seekg(0, std::ios::beg);
     initializer();
 }
 
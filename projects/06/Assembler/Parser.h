@@ -9,6 +9,18 @@
     - dest: if C-Command, return dest symbol
     - comp: if C-Command, return comp symbol
     - jump: if C-Command, return jump symbol
+    - command: return current command's type, fields and file line at once
+    - isMappedCommand: true if current command's views point into the mapped file.
+                       (They are valid until the Parser is destroyed, not only until next advance().)
+
+    Input
+    - Parser(path): The .asm file is memory-mapped and scanned in place.
+    - Parser() and setSource(source): Scan source text in memory. It must outlive the Parser.
+    - Every command and field is a std::string_view into the mapped file,
+      so no string is allocated per line.
+    - A command with white space inside(ex. "D = M") is compacted into a scratch buffer
+      which is reused, because a view can't skip characters.
+    - Returned views are valid until the next advance().
 
     Caution
     - When generated, current_command_ is initialized to ""(Empty string).
@@ -20,38 +32,60 @@
 
 #include "Global.h"
 
-#define string_end std::string::npos
-typedef std::string::size_type string_iter;
+#define string_end std::string_view::npos
+typedef std::string_view::size_type string_iter;
+
+struct Command {
+    CommandType type;
+    std::string_view symbol;
+    std::string_view dest;
+    std::string_view comp;
+    std::string_view jump;
+    int line;
+};
 
 class Parser {
 private:
-    std::ifstream input_;
-    std::string current_command_;
-    std::string next_command_;
+    void* mapped_;
+    std::size_t mapped_size_;
+    std::string fallback_;
+    std::string_view source_;
+    std::size_t cursor_;
+    std::string_view current_command_;
+    std::string_view next_command_;
+    std::string scratch_[2];
+    int next_scratch_;
     CommandType type_;
     int current_command_file_line_;
     int file_line_;
     int command_address_;
 
 private:
+    void load(const std::string& path);
     void initializer();
-    std::string readCommand();
-    void deleteComment(std::string& command);
-    void deleteWhiteSpace(std::string& command);
-    void checkCommandType(const std::string& command);
-    bool isEmptyCommand(const std::string& command) const;
+    std::string_view readCommand();
+    void deleteComment(std::string_view& command) const;
+    std::string_view deleteWhiteSpace(std::string_view command, std::string& scratch) const;
+    void checkCommandType(std::string_view command);
+    bool isEmptyCommand(std::string_view command) const;
 
 public:
+    Parser();
     Parser(std::string path);
     ~Parser();
 
+    void setSource(std::string_view source);
+    std::string_view source() const;
+
     bool hasMoreCommands() const;
     void advance();
     CommandType commandType() const;
-    std::string symbol() const;
-    std::string dest() const;
-    std::string comp() const;
-    std::string jump() const;
+    std::string_view symbol() const;
+    std::string_view dest() const;
+    std::string_view comp() const;
+    std::string_view jump() const;
+    Command command() const;
+    bool isMappedCommand() const;
     void resetCursor();
     int getCurrentCommandFileLine() const;
     int getFileLine() const;
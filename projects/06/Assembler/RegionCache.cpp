@@ -0,0 +1,112 @@
+/**
+    Implementation of RegionCache.h
+
+    Cache file(little-endian)
+    "HACKINC1", region count(u32), then for each region:
+    hash(u64), length(u32),
+    label count(u32), { name length(u32), name, offset(u32) }
+    word count(u32), { word(u16) }
+    relocation count(u32), { offset(u32), name length(u32), name }
+*/
+
+#include "RegionCache.h"
+#include "BinaryIO.h"
+
+namespace {
+    const std::string_view MAGIC = "HACKINC1";
+}
+
+/* =========== PUBLIC ============= */
+
+uint64_t RegionCache::hashOf(std::string_view text) {
+    uint64_t hash = 14695981039346656037ull;
+    for (char c : text) {
+        hash ^= static_cast<unsigned char>(c);
+        hash *= 1099511628211ull;
+    }
+    return hash;
+}
+
+void RegionCache::load(const std::string& path) {
+    regions_.clear();
+    inserted_ = false;
+    std::string buffer;
+    if (!readFile(path, buffer)) return;
+
+    try {
+        BinaryReader reader(buffer);
+        if (!reader.expect(MAGIC)) return;
+        uint64_t count = reader.readInteger(4);
+        for (uint64_t i = 0; i < count; ++i) {
+            Region region;
+            region.used = false;
+            region.hash = reader.readInteger(8);
+            region.length = static_cast<uint32_t>(reader.readInteger(4));
+            for (uint64_t n = reader.readInteger(4); n > 0; --n) {
+                std::string name = reader.readString();
+                region.labels.push_back({name, static_cast<uint32_t>(reader.readInteger(4))});
+            }
+            region.words.resize(static_cast<std::size_t>(reader.readInteger(4)));
+            for (uint16_t& word : region.words) word = static_cast<uint16_t>(reader.readInteger(2));
+            for (uint64_t n = reader.readInteger(4); n > 0; --n) {
+                uint32_t offset = static_cast<uint32_t>(reader.readInteger(4));
+                region.relocations.push_back({offset, reader.readString()});
+            }
+            regions_.emplace(region.hash, std::move(region));
+        }
+    } catch (std::exception& e) {
+        regions_.clear();
+    }
+}
+
+void RegionCache::save(const std::string& path) const {
+    std::size_t count = 0;
+    for (const auto& entry : regions_) count += entry.second.used ? 1 : 0;
+
+    std::string buffer(MAGIC);
+    writeInteger(buffer, count, 4);
+    for (const auto& entry : regions_) {
+        const Region& region = entry.second;
+        if (!region.used) continue;
+        writeInteger(buffer, region.hash, 8);
+        writeInteger(buffer, region.length, 4);
+        writeInteger(buffer, region.labels.size(), 4);
+        for (const auto& label : region.labels) {
+            writeString(buffer, label.first);
+            writeInteger(buffer, label.second, 4);
+        }
+        writeInteger(buffer, region.words.size(), 4);
+        for (uint16_t word : region.words) writeInteger(buffer, word, 2);
+        writeInteger(buffer, region.relocations.size(), 4);
+        for (const auto& relocation : region.relocations) {
+            writeInteger(buffer, relocation.first, 4);
+            writeString(buffer, relocation.second);
+        }
+    }
+
+    std::ofstream output(path, std::ios::out | std::ios::binary);
+    if (output.fail()) throw fileException(path);
+    output.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+}
+
+const Region* RegionCache::find(uint64_t hash, uint32_t length) {
+    auto entry = regions_.find(hash);
+    if (entry == regions_.end() || entry->second.length != length) return nullptr;
+    entry->second.used = true;
+    return &entry->second;
+}
+
+const Region& RegionCache::insert(Region&& region) {
+    inserted_ = true;
+    region.used = true;
+    uint64_t hash = region.hash;
+    return regions_.insert_or_assign(hash, std::move(region)).first->second;
+}
+
+bool RegionCache::isDirty() const {
+    if (inserted_) return true;
+    for (const auto& entry : regions_) {
+        if (!entry.second.used) return true;
+    }
+    return false;
+}
\ No newline at end of file
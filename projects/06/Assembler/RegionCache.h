@@ -0,0 +1,52 @@
+/**
+    RegionCache Module(Class)
+    Cache for incremental assembly.
+
+    Region
+    - The source is split in front of every label line. A region is the label line
+      and the commands until the next label line(the first region may have no label).
+    - Region is identified by the hash(FNV-1a 64bit) and length of its text,
+      so a region is reused wherever it moves in the file.
+    - words: encoded words. A symbolic A-Command is left as 0, and listed in relocations
+      with its word offset, because its address depends on the rest of the program.
+    - labels: labels defined in the region, with their word offset.
+
+    Routines
+    - hashOf(text)
+    - load(path): read cache file. A missing or broken file is an empty cache.
+    - save(path): write regions used since load(), so stale regions are dropped.
+    - find(hash, length): return cached region(and mark it used) or nullptr.
+    - insert(region): add region(marked used) and return the stored one.
+    - isDirty: true if a region was inserted, or a loaded region wasn't used.
+*/
+
+#ifndef __REGION_CACHE_H__
+#define __REGION_CACHE_H__
+
+#include "Global.h"
+
+struct Region {
+    uint64_t hash;
+    bool used;
+    uint32_t length;
+    std::vector<std::pair<std::string, uint32_t>> labels;
+    std::vector<uint16_t> words;
+    std::vector<std::pair<uint32_t, std::string>> relocations;
+};
+
+class RegionCache {
+private:
+    std::unordered_map<uint64_t, Region> regions_;
+    bool inserted_ = false;
+
+public:
+    static uint64_t hashOf(std::string_view text);
+
+    void load(const std::string& path);
+    void save(const std::string& path) const;
+    const Region* find(uint64_t hash, uint32_t length);
+    const Region& insert(Region&& region);
+    bool isDirty() const;
+};
+
+#endif
\ No newline at end of file
@@ -0,0 +1,101 @@
+/**
+    Implementation of SourceMap.h
+*/
+
+#include "SourceMap.h"
+#include "BinaryIO.h"
+
+namespace {
+    const std::string_view MAGIC = "HACKMAP1";
+
+    void writeIntervals(std::string& buffer, const std::vector<SourceInterval>& intervals) {
+        writeInteger(buffer, intervals.size(), 4);
+        for (const SourceInterval& interval : intervals) {
+            writeInteger(buffer, interval.begin, 4);
+            writeInteger(buffer, interval.name, 4);
+        }
+    }
+
+    void readIntervals(BinaryReader& reader, std::vector<SourceInterval>& intervals, std::size_t names) {
+        intervals.resize(static_cast<std::size_t>(reader.readInteger(4)));
+        uint32_t previous = 0;
+        for (SourceInterval& interval : intervals) {
+            interval.begin = static_cast<uint32_t>(reader.readInteger(4));
+            interval.name = static_cast<uint32_t>(reader.readInteger(4));
+            if (interval.begin < previous || interval.name >= names) throw std::runtime_error("Broken interval.");
+            previous = interval.begin;
+        }
+    }
+}
+
+/* =========== PRIVATE ============= */
+
+std::string_view SourceMap::find(const std::vector<SourceInterval>& intervals, uint32_t address) const {
+    auto next = std::upper_bound(intervals.begin(), intervals.end(), address,
+                                 [](uint32_t value, const SourceInterval& interval) { return value < interval.begin; });
+    if (next == intervals.begin()) return "";
+    return names[std::prev(next)->name];
+}
+
+/* =========== PUBLIC ============= */
+
+bool SourceMap::isFunctionLabel(std::string_view name) {
+    return name.find('.') != std::string_view::npos && name.find('$') == std::string_view::npos;
+}
+
+void SourceMap::addLabel(std::string_view name, uint32_t address) {
+    uint32_t index = static_cast<uint32_t>(names.size());
+    names.emplace_back(name);
+    labels.push_back({address, index});
+    if (isFunctionLabel(name)) functions.push_back({address, index});
+}
+
+void SourceMap::addWord(uint32_t line) {
+    lines.push_back(line);
+}
+
+int SourceMap::line(uint32_t address) const {
+    return (address < lines.size()) ? static_cast<int>(lines[address]) : 0;
+}
+
+std::string_view SourceMap::label(uint32_t address) const {
+    return find(labels, address);
+}
+
+std::string_view SourceMap::function(uint32_t address) const {
+    return find(functions, address);
+}
+
+void SourceMap::load(const std::string& path) {
+    std::string buffer;
+    if (!readFile(path, buffer)) throw fileException(path);
+
+    try {
+        BinaryReader reader(buffer);
+        if (!reader.expect(MAGIC)) throw fileException(path);
+        names.resize(static_cast<std::size_t>(reader.readInteger(4)));
+        for (std::string& name : names) name = reader.readString();
+        lines.resize(static_cast<std::size_t>(reader.readInteger(4)));
+        for (uint32_t& line : lines) line = static_cast<uint32_t>(reader.readInteger(4));
+        readIntervals(reader, labels, names.size());
+        readIntervals(reader, functions, names.size());
+    } catch (fileException& e) {
+        throw e;
+    } catch (std::exception& e) {
+        throw fileException(path);
+    }
+}
+
+void SourceMap::save(const std::string& path) const {
+    std::string buffer(MAGIC);
+    writeInteger(buffer, names.size(), 4);
+    for (const std::string& name : names) writeString(buffer, name);
+    writeInteger(buffer, lines.size(), 4);
+    for (uint32_t line : lines) writeInteger(buffer, line, 4);
+    writeIntervals(buffer, labels);
+    writeIntervals(buffer, functions);
+
+    std::ofstream output(path, std::ios::out | std::ios::binary);
+    if (output.fail()) throw fileException(path);
+    output.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+}
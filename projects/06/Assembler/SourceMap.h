@@ -0,0 +1,60 @@
+/**
+    SourceMap Module
+    Address/source map(.hmap) of one assembled program(--map).
+
+    Sections
+    - names: label names. Intervals refer to a name by its index.
+    - lines: .asm file line of each ROM address.
+    - labels: (begin address, name) sorted by begin. An address belongs to the
+              last label whose begin isn't after it(the nearest preceding label).
+    - functions: same as labels, but only VM function labels.
+                 CodeWriter::writeFunction emits "(Class.function)", so a function label
+                 has a '.' and no '$'(labels inside a function are "Class.function$label").
+
+    File(little-endian, see BinaryIO.h)
+    "HACKMAP1",
+    name count(u32), { name }
+    word count(u32), { line(u32) }
+    label count(u32), { begin(u32), name index(u32) }
+    function count(u32), { begin(u32), name index(u32) }
+
+    Routines
+    - addLabel(name, address): labels must be added in address order.
+    - addWord(line): add the line of the next address.
+    - line(address), label(address), function(address): lookup by binary search.
+      label and function return "" if the address is in front of every label.
+    - load(path), save(path)
+*/
+
+#ifndef __SOURCE_MAP_H__
+#define __SOURCE_MAP_H__
+
+#include "Global.h"
+
+struct SourceInterval {
+    uint32_t begin;
+    uint32_t name;
+};
+
+struct SourceMap {
+    std::vector<std::string> names;
+    std::vector<uint32_t> lines;
+    std::vector<SourceInterval> labels;
+    std::vector<SourceInterval> functions;
+
+    static bool isFunctionLabel(std::string_view name);
+
+    void addLabel(std::string_view name, uint32_t address);
+    void addWord(uint32_t line);
+    int line(uint32_t address) const;
+    std::string_view label(uint32_t address) const;
+    std::string_view function(uint32_t address) const;
+
+    void load(const std::string& path);
+    void save(const std::string& path) const;
+
+private:
+    std::string_view find(const std::vector<SourceInterval>& intervals, uint32_t address) const;
+};
+
+#endif
@@ -0,0 +1,96 @@
+/**
+    Stats Module
+    Per-phase timing and counters of one assembly(--stats).
+
+    Phases(seconds)
+    - parse: map the file and split it into commands.
+    - labels: define labels and allocate variables(single pass: patch forward references).
+    - optimize: peephole rewrites(-O).
+    - encode: encode commands to words(and render text words).
+    - write: write words to the output file.
+    - flush: flush and close the output file.
+    The serial paths(two-pass, single pass, symbol-free) parse each command as they go,
+    so with --stats each advance of the parser is timed into parse(two clock reads per command),
+    and it is left out of labels and encode. They write each word to the stream buffer as it is
+    encoded, so encode includes write. The staged path(-O, --threads, --map) has each phase apart.
+
+    Counters
+    - lines, commands(parsed, labels included, before -O), labels, variables, bytes(read), words(emitted)
+
+    Routines
+    - PhaseTimer(total, nested): add the time until the timer is destroyed to total.
+                                 Time added to *nested meanwhile(an inner phase) is left out.
+    - AssemblerStats::print(output, format): human-readable text or one JSON object.
+*/
+
+#ifndef __STATS_H__
+#define __STATS_H__
+
+#include "Global.h"
+#include <chrono>
+#include <iomanip>
+
+class PhaseTimer {
+private:
+    double& total_;
+    const double* nested_;
+    double nested_begin_;
+    std::chrono::steady_clock::time_point begin_;
+
+public:
+    PhaseTimer(double& total, const double* nested = nullptr)
+    : total_(total), nested_(nested), nested_begin_(nested ? *nested : 0), begin_(std::chrono::steady_clock::now()) { }
+    ~PhaseTimer() {
+        total_ += std::chrono::duration<double>(std::chrono::steady_clock::now() - begin_).count();
+        if (nested_ != nullptr) total_ -= *nested_ - nested_begin_;
+    }
+};
+
+struct AssemblerStats {
+    double parse = 0;
+    double labels = 0;
+    double optimize = 0;
+    double encode = 0;
+    double write = 0;
+    double flush = 0;
+    std::size_t lines = 0;
+    std::size_t commands = 0;
+    std::size_t label_count = 0;
+    std::size_t variables = 0;
+    std::size_t bytes = 0;
+    std::size_t words = 0;
+
+    void print(std::ostream& output, StatsFormat format) const {
+        const std::pair<const char*, double> phases[] = {
+            {"parse", parse}, {"labels", labels}, {"optimize", optimize},
+            {"encode", encode}, {"write", write}, {"flush", flush}
+        };
+        const std::pair<const char*, std::size_t> counters[] = {
+            {"lines", lines}, {"commands", commands}, {"labels", label_count},
+            {"variables", variables}, {"bytes", bytes}, {"words", words}
+        };
+
+        if (format == StatsFormat::json) {
+            output << "{\"time\":{";
+            for (std::size_t i = 0; i < std::size(phases); ++i)
+                output << (i ? "," : "") << '"' << phases[i].first << "\":" << std::fixed << std::setprecision(6) << phases[i].second;
+            output << "},\"count\":{";
+            for (std::size_t i = 0; i < std::size(counters); ++i)
+                output << (i ? "," : "") << '"' << counters[i].first << "\":" << counters[i].second;
+            output << "}}" << std::endl;
+            return;
+        }
+
+        double total = parse + labels + optimize + encode + write + flush;
+        output << "Phase       ms      %" << std::endl;
+        for (const auto& phase : phases) {
+            output << std::left << std::setw(8) << phase.first << std::right << std::fixed
+                   << std::setw(9) << std::setprecision(3) << phase.second * 1000
+                   << std::setw(7) << std::setprecision(1) << (total > 0 ? phase.second / total * 100 : 0) << std::endl;
+        }
+        for (const auto& counter : counters)
+            output << std::left << std::setw(10) << counter.first << std::right << counter.second << std::endl;
+    }
+};
+
+#endif
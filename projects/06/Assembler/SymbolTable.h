@@ -5,7 +5,17 @@
     - addEntry(symbol, address)
     - contains(symbol)
     - GetAddress(symbol)
-    - addVariable(symbol)
+    - addVariable(id)
+    - variableCount
+    - findOrInsert(symbol): return symbol id. A new symbol is inserted as undefined.
+    - find(symbol): return symbol id, or NOT_FOUND.
+    - isDefined(id), addressOf(id), define(id, address), name(id)
+
+    Structure
+    - Symbol names are interned in an arena(large char blocks), and never move.
+    - The table is open addressing(linear probing) over symbol ids,
+      and each slot keeps the hash so most mismatches don't touch the name.
+    - A symbol use costs one lookup: findOrInsert, then work with the id.
 */
 
 #ifndef __SYMBOL_TABLE_H__
@@ -14,53 +24,167 @@
 #include "Global.h"
 
 class SymbolTable {
+public:
+    static constexpr int NOT_FOUND = -1;
+
 private:
-    std::map<std::string, int> table_ = {
-        /* Predefined symbols */
-        {"SP",      0x0000},
-        {"LCL",     0x0001},
-        {"ARG",     0x0002},
-        {"THIS",    0x0003},
-        {"THAT",    0x0004},
-        {"R0",      0x0000},
-        {"R1",      0x0001},
-        {"R2",      0x0002},
-        {"R3",      0x0003},
-        {"R4",      0x0004},
-        {"R5",      0x0005},
-        {"R6",      0x0006},
-        {"R7",      0x0007},
-        {"R8",      0x0008},
-        {"R9",      0x0009},
-        {"R10",     0x000a},
-        {"R11",     0x000b},
-        {"R12",     0x000c},
-        {"R13",     0x000d},
-        {"R14",     0x000e},
-        {"R15",     0x000f},
-        {"SCREEN",  0x4000},
-        {"KBD",     0x6000}
-        /* ================== */
+    static constexpr int UNDEFINED = -1;
+    static constexpr std::size_t ARENA_BLOCK_SIZE = 64 * 1024;
+
+    struct Entry {
+        std::string_view name;
+        int address;
+    };
+
+    struct Slot {
+        uint32_t hash;
+        int id;
     };
+
+    std::vector<std::unique_ptr<char[]>> arena_;
+    std::size_t arena_used_ = ARENA_BLOCK_SIZE;
+    std::vector<Entry> entries_;
+    std::vector<Slot> slots_;
     int variable_address_ = 0x0010;
 
+    static uint32_t hashOf(std::string_view symbol) {
+        uint32_t hash = 2166136261u;    // FNV-1a
+        for (char c : symbol) {
+            hash ^= static_cast<unsigned char>(c);
+            hash *= 16777619u;
+        }
+        return hash;
+    }
+
+    std::string_view intern(std::string_view symbol) {
+        /* A symbol larger than a block gets a block of its own, and the current block stays the last one. */
+        if (symbol.size() > ARENA_BLOCK_SIZE) {
+            arena_.emplace_back(new char[symbol.size()]);
+            std::copy(symbol.begin(), symbol.end(), arena_.back().get());
+            std::string_view text(arena_.back().get(), symbol.size());
+            if (arena_.size() >= 2) std::swap(arena_[arena_.size() - 2], arena_.back());
+            else arena_used_ = ARENA_BLOCK_SIZE;
+            return text;
+        }
+        if (arena_.empty() || symbol.size() > ARENA_BLOCK_SIZE - arena_used_) {
+            arena_.emplace_back(new char[ARENA_BLOCK_SIZE]);
+            arena_used_ = 0;
+        }
+        char* text = arena_.back().get() + arena_used_;
+        std::copy(symbol.begin(), symbol.end(), text);
+        arena_used_ += symbol.size();
+        return std::string_view(text, symbol.size());
+    }
+
+    /* Returns the slot of symbol, or the empty slot where it should be inserted. */
+    std::size_t probe(std::string_view symbol, uint32_t hash) const {
+        std::size_t mask = slots_.size() - 1;
+        std::size_t index = hash & mask;
+        while (slots_[index].id != NOT_FOUND) {
+            const Slot& slot = slots_[index];
+            if (slot.hash == hash && entries_[slot.id].name == symbol) break;
+            index = (index + 1) & mask;
+        }
+        return index;
+    }
+
+    void grow() {
+        std::vector<Slot> old = std::move(slots_);
+        slots_.assign(old.size() * 2, {0, NOT_FOUND});
+        std::size_t mask = slots_.size() - 1;
+        for (const Slot& slot : old) {
+            if (slot.id == NOT_FOUND) continue;
+            std::size_t index = slot.hash & mask;
+            while (slots_[index].id != NOT_FOUND) index = (index + 1) & mask;
+            slots_[index] = slot;
+        }
+    }
+
 public:
-    void addEntry(std::string symbol, int address) {
-        table_.insert({symbol, address});
+    SymbolTable() : slots_(1024, {0, NOT_FOUND}) {
+        /* Predefined symbols */
+        addEntry("SP",      0x0000);
+        addEntry("LCL",     0x0001);
+        addEntry("ARG",     0x0002);
+        addEntry("THIS",    0x0003);
+        addEntry("THAT",    0x0004);
+        addEntry("R0",      0x0000);
+        addEntry("R1",      0x0001);
+        addEntry("R2",      0x0002);
+        addEntry("R3",      0x0003);
+        addEntry("R4",      0x0004);
+        addEntry("R5",      0x0005);
+        addEntry("R6",      0x0006);
+        addEntry("R7",      0x0007);
+        addEntry("R8",      0x0008);
+        addEntry("R9",      0x0009);
+        addEntry("R10",     0x000a);
+        addEntry("R11",     0x000b);
+        addEntry("R12",     0x000c);
+        addEntry("R13",     0x000d);
+        addEntry("R14",     0x000e);
+        addEntry("R15",     0x000f);
+        addEntry("SCREEN",  0x4000);
+        addEntry("KBD",     0x6000);
+        /* ================== */
+    }
+
+    int findOrInsert(std::string_view symbol) {
+        uint32_t hash = hashOf(symbol);
+        std::size_t index = probe(symbol, hash);
+        if (slots_[index].id != NOT_FOUND) return slots_[index].id;
+
+        int id = static_cast<int>(entries_.size());
+        entries_.push_back({intern(symbol), UNDEFINED});
+        slots_[index] = {hash, id};
+        if (entries_.size() * 2 > slots_.size()) grow();
+        return id;
+    }
+
+    int find(std::string_view symbol) const {
+        return slots_[probe(symbol, hashOf(symbol))].id;
+    }
+
+    bool isDefined(int id) const {
+        return entries_[id].address != UNDEFINED;
+    }
+
+    int addressOf(int id) const {
+        return entries_[id].address;
+    }
+
+    std::string_view name(int id) const {
+        return entries_[id].name;
+    }
+
+    /* The first definition is kept. */
+    void define(int id, int address) {
+        if (!isDefined(id)) entries_[id].address = address;
     }
 
-    bool contains(const std::string& symbol) const {
-        return (table_.find(symbol) != table_.end());
+    void addEntry(std::string_view symbol, int address) {
+        define(findOrInsert(symbol), address);
     }
 
-    int GetAddress(const std::string& symbol) const {
-        return table_.at(symbol);
+    bool contains(std::string_view symbol) const {
+        int id = find(symbol);
+        return id != NOT_FOUND && isDefined(id);
     }
 
-    int addVariable(std::string symbol) {
-        addEntry(symbol, variable_address_);
+    int GetAddress(std::string_view symbol) const {
+        int id = find(symbol);
+        if (id == NOT_FOUND || !isDefined(id)) throw std::out_of_range("Unknown symbol: " + std::string(symbol));
+        return addressOf(id);
+    }
+
+    int addVariable(int id) {
+        define(id, variable_address_);
         return variable_address_++;
     }
+
+    int variableCount() const {
+        return variable_address_ - 0x0010;
+    }
 };
 
 #endif
\ No newline at end of file
@@ -0,0 +1,131 @@
+/**
+    Assembler benchmark suite
+
+    Generates .asm workloads(see ProgramGenerator.h), assembles each one
+    in a child process, and reports:
+    - MB/s: .asm bytes read per second
+    - M instr/s: instructions(words) emitted per second
+    - peak RSS: maximum resident set size of the child process
+
+    Workloads: labels, variables, comments, translator,
+               and os(if --os=file.asm is given).
+    The os workload replicates a real translated program, for example
+    prompt> VMtranslator ../../../12/Pong      (08/VMtranslator, Pong + projects/12 OS)
+    prompt> AssemblerBench --os=../../../12/Pong.asm
+
+    How to use
+    prompt> g++ -std=c++17 -O2 -pthread -I.. AssemblerBench.cpp ../Assembler.cpp ../Parser.cpp ../RegionCache.cpp ../ObjectFile.cpp ../Optimizer.cpp ../SourceMap.cpp -o AssemblerBench
+    prompt> AssemblerBench [--words=N] [--repeat=N] [--shape=name] [--os=file.asm]
+                           [--single-pass] [--threads=N] [--format=text|bin]
+    --words: instructions per workload(default 32768, the ROM size).
+    --repeat: assemble each workload N times and take the best(default 5).
+*/
+
+#include <chrono>
+#include <filesystem>
+#include <iomanip>
+#include <sys/resource.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#include "ProgramGenerator.h"
+#include "../Assembler.h"
+
+struct Workload {
+    std::string name;
+    std::string path;
+    long long words;
+};
+
+static double assembleBest(const Workload& workload, const AssemblerOption& option, int repeat) {
+    double best = 0.0;
+    for (int i = 0; i < repeat; ++i) {
+        auto start = std::chrono::steady_clock::now();
+        Assembler assembler(workload.path, option);
+        assembler.translate();
+        auto end = std::chrono::steady_clock::now();
+        double seconds = std::chrono::duration<double>(end - start).count();
+        if (i == 0 || seconds < best) best = seconds;
+    }
+    return best;
+}
+
+/* Each workload runs in its own process, so peak RSS belongs to that workload only. */
+static void run(const Workload& workload, const AssemblerOption& option, int repeat) {
+    double megabytes = static_cast<double>(std::filesystem::file_size(workload.path)) / (1024.0 * 1024.0);
+    std::cout << std::left << std::setw(12) << workload.name << std::right << std::fixed << std::setprecision(2)
+              << std::setw(9) << megabytes << " MB" << std::setw(10) << workload.words << " words" << std::flush;
+
+    pid_t pid = fork();
+    if (pid == 0) {
+        try {
+            double seconds = assembleBest(workload, option, repeat);
+            std::cout << std::setw(10) << megabytes / seconds << " MB/s"
+                      << std::setw(10) << workload.words / seconds / 1e6 << " M instr/s" << std::flush;
+        } catch (std::exception& e) {
+            std::cout << "  " << e.what() << std::flush;
+        }
+        _exit(0);
+    }
+
+    int status = 0;
+    struct rusage usage;
+    wait4(pid, &status, 0, &usage);
+    std::cout << std::setw(10) << usage.ru_maxrss / 1024.0 << " MB peak RSS" << std::endl;
+}
+
+static long long countWords(const std::string& source) {
+    AssembleResult result = assemble(source);
+    return static_cast<long long>(result.words.size());
+}
+
+int main(int argc, char* argv[]) {
+    long long words = 32768;
+    int repeat = 5;
+    std::string only = "";
+    std::string os_path = "";
+    AssemblerOption option;
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg.rfind("--words=", 0) == 0) words = std::stoll(arg.substr(8));
+        else if (arg.rfind("--repeat=", 0) == 0) repeat = std::stoi(arg.substr(9));
+        else if (arg.rfind("--shape=", 0) == 0) only = arg.substr(8);
+        else if (arg.rfind("--os=", 0) == 0) os_path = arg.substr(5);
+        else if (arg == "--single-pass") option.single_pass = true;
+        else if (arg.rfind("--threads=", 0) == 0) option.threads = std::stoi(arg.substr(10));
+        else if (arg == "--format=bin") option.format = OutputFormat::binary;
+        else if (arg == "--format=text") option.format = OutputFormat::text;
+    }
+
+    std::filesystem::path directory = std::filesystem::temp_directory_path() / "hack_assembler_bench";
+    std::filesystem::create_directories(directory);
+
+    const std::vector<std::pair<std::string, ProgramShape>> shapes = {
+        {"labels", ProgramShape::labels},
+        {"variables", ProgramShape::variables},
+        {"comments", ProgramShape::comments},
+        {"translator", ProgramShape::translator}
+    };
+
+    ProgramGenerator generator;
+    std::vector<Workload> workloads;
+    for (const auto& shape : shapes) {
+        if (!only.empty() && only != shape.first) continue;
+        std::string source = generator.generate(shape.second, words);
+        std::string path = (directory / (shape.first + ".asm")).string();
+        std::ofstream(path) << source;
+        workloads.push_back({shape.first, path, countWords(source)});
+    }
+    if (!os_path.empty() && (only.empty() || only == "os")) {
+        std::ifstream input(os_path);
+        if (input.fail()) throw fileException(os_path);
+        std::stringstream buffer;
+        buffer << input.rdbuf();
+        std::string source = generator.replicate(buffer.str(), words);
+        std::string path = (directory / "os.asm").string();
+        std::ofstream(path) << source;
+        workloads.push_back({"os", path, countWords(source)});
+    }
+
+    for (const Workload& workload : workloads) run(workload, option, repeat);
+    return 0;
+}
\ No newline at end of file
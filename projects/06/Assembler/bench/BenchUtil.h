@@ -0,0 +1,31 @@
+/**
+    BenchUtil Module
+    Helpers shared by the micro benchmarks(CodeBench, SymbolTableBench, ClassifyBench).
+
+    Routines
+    - measure(function): run function once, and return the seconds it took.
+    - labelName(i): the i-th label of a VMtranslator shaped program. By i % 3, it is
+                    RETURN<i>, Class<n>.func<i> or Class<n>.func<i-1>$LABEL<i>.
+*/
+
+#ifndef __BENCH_UTIL_H__
+#define __BENCH_UTIL_H__
+
+#include <chrono>
+#include "../Global.h"
+
+template <typename Function>
+double measure(Function function) {
+    auto start = std::chrono::steady_clock::now();
+    function();
+    auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double>(end - start).count();
+}
+
+inline std::string labelName(int i) {
+    if (i % 3 == 0) return "RETURN" + std::to_string(i);
+    if (i % 3 == 1) return "Class" + std::to_string(i % 97) + ".func" + std::to_string(i);
+    return "Class" + std::to_string(i % 97) + ".func" + std::to_string(i - 1) + "$LABEL" + std::to_string(i);
+}
+
+#endif
@@ -0,0 +1,60 @@
+/**
+    A-Command classification benchmark
+
+    Label-heavy A-Command operands(@RETURN<n>, @Class<n>.func<n>$LABEL<n>, ...)
+    mixed with some numbers. Each operand is classified as number or symbol, and
+    the old way(std::stoi inside try/catch, so every symbol throws) is measured
+    as the baseline against Code::canTranslateToBinary and Code::isSymbol(one character scan).
+
+    How to use
+    prompt> g++ -std=c++17 -O2 -I.. ClassifyBench.cpp -o ClassifyBench
+    prompt> ClassifyBench [labels]
+*/
+
+#include "BenchUtil.h"
+#include "../Code.h"
+
+bool isNumberWithException(const std::string& symbol) {
+    try {
+        std::stoi(symbol);
+        return true;
+    } catch (std::exception& e) {
+        return false;
+    }
+}
+
+int main(int argc, char* argv[]) {
+    const int labels = (argc > 1) ? std::stoi(argv[1]) : 100000;
+    const int uses = 4;
+
+    /* Every 8th operand is a number, as in "@<constant>" of push constant. */
+    std::vector<std::string> operands;
+    for (int i = 0; i < labels * uses; ++i) {
+        int label = (static_cast<long long>(i) * 7919) % labels;
+        if (i % 8 == 0) operands.push_back(std::to_string(i % 32768));
+        else operands.push_back(labelName(label));
+    }
+
+    long long numbers_exception = 0;
+    double exception_seconds = measure([&]() {
+        for (const std::string& operand : operands) numbers_exception += isNumberWithException(operand);
+    });
+
+    Code code;
+    long long numbers_scan = 0;
+    long long invalid = 0;
+    double scan_seconds = measure([&]() {
+        for (const std::string& operand : operands) {
+            if (code.canTranslateToBinary(operand, SymbolType::address)) ++numbers_scan;
+            else if (!Code::isSymbol(operand)) ++invalid;
+        }
+    });
+
+    double count = static_cast<double>(operands.size());
+    std::cout << "labels: " << labels << ", A-Commands: " << operands.size() << std::endl;
+    std::cout << "std::stoi + try/catch: " << count / exception_seconds / 1e6 << " M operands/sec" << std::endl;
+    std::cout << "character scan:        " << count / scan_seconds / 1e6 << " M operands/sec" << std::endl;
+    std::cout << "speedup: " << exception_seconds / scan_seconds << "x"
+              << ((numbers_exception == numbers_scan && invalid == 0) ? "" : " (CLASSIFICATION MISMATCH)") << std::endl;
+    return 0;
+}
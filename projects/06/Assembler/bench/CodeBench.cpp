@@ -0,0 +1,97 @@
+/**
+    Code micro benchmark
+
+    Measures C-Command encoding speed of the Code module(instructions/sec).
+    The mnemonic mix is the one that VMtranslator output uses most.
+    The old Code(std::map<std::string, std::string> tables of bit strings,
+    "111" + comp + dest + jump) is measured as the baseline against the
+    perfect hash tables(Code::encodeCompute + Code::toText). Both make the 16 character line.
+
+    How to use
+    prompt> g++ -std=c++17 -O2 -I.. CodeBench.cpp -o CodeBench
+    prompt> CodeBench [iterations]
+*/
+
+#include "BenchUtil.h"
+#include "../Code.h"
+
+struct CCommand {
+    std::string dest;
+    std::string comp;
+    std::string jump;
+};
+
+class MapCode {
+private:
+    const std::map<std::string, std::string> DEST = {
+        {"",    "000"}, {"M",   "001"}, {"D",   "010"}, {"MD",  "011"},
+        {"A",   "100"}, {"AM",  "101"}, {"AD",  "110"}, {"AMD", "111"}
+    };
+    const std::map<std::string, std::string> COMP = {
+        {"0",   "0101010"}, {"1",   "0111111"}, {"-1",  "0111010"}, {"D",   "0001100"},
+        {"A",   "0110000"}, {"M",   "1110000"}, {"!D",  "0001101"}, {"!A",  "0110001"},
+        {"!M",  "1110001"}, {"-D",  "0001111"}, {"-A",  "0110011"}, {"-M",  "1110011"},
+        {"D+1", "0011111"}, {"A+1", "0110111"}, {"M+1", "1110111"}, {"D-1", "0001110"},
+        {"A-1", "0110010"}, {"M-1", "1110010"}, {"D+A", "0000010"}, {"D+M", "1000010"},
+        {"D-A", "0010011"}, {"D-M", "1010011"}, {"A-D", "0000111"}, {"M-D", "1000111"},
+        {"D&A", "0000000"}, {"D&M", "1000000"}, {"D|A", "0010101"}, {"D|M", "1010101"}
+    };
+    const std::map<std::string, std::string> JUMP = {
+        {"",    "000"}, {"JGT", "001"}, {"JEQ", "010"}, {"JGE", "011"},
+        {"JLT", "100"}, {"JNE", "101"}, {"JLE", "110"}, {"JMP", "111"}
+    };
+
+public:
+    std::string dest(const std::string& symbol) const { return DEST.at(symbol); }
+    std::string comp(const std::string& symbol) const { return COMP.at(symbol); }
+    std::string jump(const std::string& symbol) const { return JUMP.at(symbol); }
+};
+
+/* The same for both encoders: position weighted sum of the line. */
+uint32_t checksumOf(const char* text) {
+    uint32_t sum = 0;
+    for (int i = 0; i < 16; ++i) sum += static_cast<uint32_t>(text[i]) * (i + 1);
+    return sum;
+}
+
+int main(int argc, char* argv[]) {
+    const std::vector<CCommand> commands = {
+        {"M",   "M-1", ""},     {"A",   "M",   ""},     {"D",   "M",   ""},
+        {"M",   "D",   ""},     {"M",   "M+1", ""},     {"D",   "A",   ""},
+        {"A",   "D+A", ""},     {"",    "0",   "JMP"},  {"D",   "D-M", ""},
+        {"",    "D",   "JNE"},  {"AM",  "M-1", ""},     {"MD",  "M+1", ""},
+        {"D",   "D+M", ""},     {"M",   "-1",  ""},     {"",    "D",   "JEQ"},
+        {"M",   "!M",  ""},     {"D",   "D&M", ""},     {"AMD", "D|M", ""}
+    };
+    long long iterations = (argc > 1) ? std::stoll(argv[1]) : 2000000;
+
+    MapCode map_code;
+    uint32_t checksum_map = 0;
+    double map_seconds = measure([&]() {
+        for (long long i = 0; i < iterations; ++i) {
+            for (const CCommand& command : commands) {
+                std::string line = "111" + map_code.comp(command.comp) + map_code.dest(command.dest) + map_code.jump(command.jump);
+                checksum_map += checksumOf(line.data());
+            }
+        }
+    });
+
+    Code code;
+    uint32_t checksum_hash = 0;
+    double hash_seconds = measure([&]() {
+        char line[16];
+        for (long long i = 0; i < iterations; ++i) {
+            for (const CCommand& command : commands) {
+                Code::toText(static_cast<uint16_t>(code.encodeCompute(command.dest, command.comp, command.jump)), line);
+                checksum_hash += checksumOf(line);
+            }
+        }
+    });
+
+    double count = static_cast<double>(iterations) * commands.size();
+    std::cout << "std::map tables:   " << count / map_seconds / 1e6 << " M instructions/sec" << std::endl;
+    std::cout << "perfect hash:      " << count / hash_seconds / 1e6 << " M instructions/sec" << std::endl;
+    std::cout << "speedup: " << map_seconds / hash_seconds << "x"
+              << ((checksum_map == checksum_hash) ? "" : " (CHECKSUM MISMATCH)") << std::endl;
+    return 0;
+}
@@ -0,0 +1,224 @@
+/**
+    ProgramGenerator Module(Class)
+    Generates synthetic Hack assembly(.asm) workloads for benchmarks.
+
+    Shapes
+    - labels: short blocks, one label per 2~3 instructions, jumps to labels defined later.
+    - variables: most A-Commands refer to a distinct variable.
+    - comments: long comment lines, blank lines and indentation around few instructions.
+    - translator: push/pop/arithmetic/call/return sequences as VMtranslator(CodeWriter) writes them.
+    - replicate: copies of a real .asm file(ex. projects/12 OS translated by VMtranslator),
+                 with every user symbol renamed per copy so labels stay unique.
+
+    Routines
+    - generate(shape, words): return .asm text which has at least 'words' instructions.
+    - replicate(source, words): same, from a given .asm text.
+*/
+
+#ifndef __PROGRAM_GENERATOR_H__
+#define __PROGRAM_GENERATOR_H__
+
+#include <sstream>
+#include <cctype>
+#include "../Global.h"
+
+enum class ProgramShape { labels = 0, variables = 1, comments = 2, translator = 3 };
+
+class ProgramGenerator {
+private:
+    std::ostringstream output_;
+    long long words_ = 0;
+    int label_count_ = 0;
+    uint32_t random_ = 12345;
+
+    int nextRandom(int range) {
+        random_ = random_ * 1103515245u + 12345u;
+        return static_cast<int>((random_ >> 8) % static_cast<uint32_t>(range));
+    }
+
+    void instruction(const std::string& command) {
+        output_ << command << "\n";
+        ++words_;
+    }
+
+    void label(const std::string& name) {
+        output_ << "(" << name << ")" << "\n";
+    }
+
+    void labelBlock() {
+        int id = label_count_++;
+        label("BLOCK" + std::to_string(id));
+        instruction("@BLOCK" + std::to_string(id + 1 + nextRandom(64)));
+        instruction(nextRandom(2) ? "D;JGT" : "0;JMP");
+        if (nextRandom(2)) instruction("D=D-1");
+    }
+
+    void variableBlock() {
+        instruction("@var" + std::to_string(nextRandom(4096)) + "." + std::to_string(label_count_++ % 512));
+        instruction(nextRandom(2) ? "M=D" : "D=M");
+    }
+
+    void commentBlock() {
+        output_ << "// ---------------------------------------------------------------------" << "\n";
+        output_ << "// block " << label_count_++ << ": this comment is long to stress the comment stripping of Parser" << "\n";
+        output_ << "\n";
+        output_ << "        @" << nextRandom(32768) << "        // load constant" << "\n";
+        output_ << "\tD = A\t\t// D = constant" << "\n";
+        output_ << "    @R13    // temporary" << "\n";
+        output_ << "    M=D     // store" << "\n";
+        words_ += 4;
+    }
+
+    void push(const std::string& segment, int index) {
+        if (segment == "constant") {
+            instruction("@" + std::to_string(index));
+            instruction("D=A");
+        } else if (segment == "static") {
+            instruction("@Class" + std::to_string(label_count_ % 37) + "." + std::to_string(index));
+            instruction("D=M");
+        } else {
+            instruction("@" + segment);
+            instruction("D=M");
+            instruction("@" + std::to_string(index));
+            instruction("A=D+A");
+            instruction("D=M");
+        }
+        pushD();
+    }
+
+    void pushD() {
+        instruction("@SP");
+        instruction("A=M");
+        instruction("M=D");
+        instruction("@SP");
+        instruction("M=M+1");
+    }
+
+    void popD() {
+        instruction("@SP");
+        instruction("M=M-1");
+        instruction("@SP");
+        instruction("A=M");
+        instruction("D=M");
+    }
+
+    void compare(const std::string& jump) {
+        int id = label_count_++;
+        popD();
+        instruction("@R13");
+        instruction("M=D");
+        popD();
+        instruction("@R13");
+        instruction("D=D-M");
+        instruction("@TRUE" + std::to_string(id));
+        instruction("D;" + jump);
+        instruction("D=0");
+        instruction("@END" + std::to_string(id));
+        instruction("0;JMP");
+        label("TRUE" + std::to_string(id));
+        instruction("D=-1");
+        label("END" + std::to_string(id));
+        pushD();
+    }
+
+    void call(const std::string& function) {
+        int id = label_count_++;
+        instruction("@RETURN" + std::to_string(id));
+        instruction("D=A");
+        pushD();
+        for (const char* segment : {"LCL", "ARG", "THIS", "THAT"}) {
+            instruction(std::string("@") + segment);
+            instruction("D=M");
+            pushD();
+        }
+        instruction("@SP");
+        instruction("D=M");
+        instruction("@7");
+        instruction("D=D-A");
+        instruction("@ARG");
+        instruction("M=D");
+        instruction("@" + function);
+        instruction("0;JMP");
+        label("RETURN" + std::to_string(id));
+    }
+
+    void translatorFunction(int index) {
+        std::string name = "Class" + std::to_string(index % 37) + ".func" + std::to_string(index);
+        label(name);
+        for (int i = 0; i < 2; ++i) push("constant", 0);
+        for (int statement = 0; statement < 6; ++statement) {
+            int kind = nextRandom(5);
+            if (kind == 0) push("LCL", nextRandom(4));
+            else if (kind == 1) push("static", nextRandom(8));
+            else if (kind == 2) compare(nextRandom(2) ? "JEQ" : "JLT");
+            else if (kind == 3) call("Class" + std::to_string(nextRandom(37)) + ".func" + std::to_string(nextRandom(index + 1)));
+            else {
+                label(name + "$WHILE" + std::to_string(statement));
+                popD();
+                instruction("@" + name + "$WHILE" + std::to_string(statement));
+                instruction("D;JNE");
+            }
+        }
+        instruction("@R15");
+        instruction("A=M");
+        instruction("0;JMP");
+    }
+
+    void reset() {
+        output_.str("");
+        words_ = 0;
+        label_count_ = 0;
+        random_ = 12345;
+    }
+
+public:
+    std::string generate(ProgramShape shape, long long words) {
+        reset();
+        int functions = 0;
+        while (words_ < words) {
+            if (shape == ProgramShape::labels) labelBlock();
+            else if (shape == ProgramShape::variables) variableBlock();
+            else if (shape == ProgramShape::comments) commentBlock();
+            else translatorFunction(functions++);
+        }
+        /* Label blocks jump forward, so the last targets must exist. */
+        if (shape == ProgramShape::labels) {
+            for (int i = 0; i <= 64; ++i) label("BLOCK" + std::to_string(label_count_ + i));
+            instruction("0;JMP");
+        }
+        return output_.str();
+    }
+
+    std::string replicate(const std::string& source, long long words) {
+        static const std::vector<std::string> PREDEFINED = {
+            "SP", "LCL", "ARG", "THIS", "THAT", "SCREEN", "KBD",
+            "R0", "R1", "R2", "R3", "R4", "R5", "R6", "R7",
+            "R8", "R9", "R10", "R11", "R12", "R13", "R14", "R15"
+        };
+        reset();
+        for (int copy = 0; words_ < words; ++copy) {
+            long long words_before = words_;
+            std::istringstream input(source);
+            std::string line;
+            while (std::getline(input, line)) {
+                std::string::size_type begin = line.find_first_not_of(" \t");
+                if (begin == std::string::npos || line.compare(begin, 2, "//") == 0) {
+                    output_ << line << "\n";
+                    continue;
+                }
+                char head = line[begin];
+                std::string::size_type end = line.find_first_of(" \t)/", begin + 1);
+                std::string symbol = line.substr(begin + 1, (end == std::string::npos ? line.size() : end) - begin - 1);
+                bool user_symbol = (head == '@' || head == '(') && !symbol.empty() && !std::isdigit(static_cast<unsigned char>(symbol[0]))
+                                   && std::find(PREDEFINED.begin(), PREDEFINED.end(), symbol) == PREDEFINED.end();
+                if (user_symbol) output_ << head << symbol << "_" << copy << (head == '(' ? ")" : "") << "\n";
+                else output_ << line << "\n";
+                if (head != '(') ++words_;
+            }
+            if (words_ == words_before) break;
+        }
+        return output_.str();
+    }
+};
+
+#endif
\ No newline at end of file
@@ -0,0 +1,74 @@
+/**
+    SymbolTable benchmark
+
+    Label-heavy workload shaped like VMtranslator output:
+    RETURN<n>, Class<n>.func<n> and Class<n>.func<n>$LABEL<n> labels,
+    each defined once and used several times, plus some variables.
+    The old std::map<std::string, int> table(contains -> GetAddress -> addVariable)
+    is measured as the baseline.
+
+    How to use
+    prompt> g++ -std=c++17 -O2 -I.. SymbolTableBench.cpp -o SymbolTableBench
+    prompt> SymbolTableBench [labels]
+*/
+
+#include "BenchUtil.h"
+#include "../SymbolTable.h"
+
+class MapSymbolTable {
+private:
+    std::map<std::string, int> table_;
+    int variable_address_ = 0x0010;
+
+public:
+    void addEntry(std::string symbol, int address) { table_.insert({symbol, address}); }
+    bool contains(const std::string& symbol) const { return table_.find(symbol) != table_.end(); }
+    int GetAddress(const std::string& symbol) const { return table_.at(symbol); }
+    int addVariable(std::string symbol) {
+        addEntry(symbol, variable_address_);
+        return variable_address_++;
+    }
+};
+
+int main(int argc, char* argv[]) {
+    const int labels = (argc > 1) ? std::stoi(argv[1]) : 100000;
+    const int uses = 4;
+
+    std::vector<std::string> definitions;
+    for (int i = 0; i < labels; ++i) definitions.push_back(labelName(i));
+    /* Uses are spread over the program, and every 50th use is a new variable. */
+    std::vector<std::string> references;
+    for (int i = 0; i < labels * uses; ++i) {
+        if (i % 50 == 0) references.push_back("Static" + std::to_string(i % 1000) + "." + std::to_string(i % 240));
+        else references.push_back(definitions[(static_cast<long long>(i) * 7919) % labels]);
+    }
+
+    long long checksum_map = 0;
+    double map_seconds = measure([&]() {
+        MapSymbolTable table;
+        for (int i = 0; i < labels; ++i) table.addEntry(definitions[i], i);
+        for (const std::string& symbol : references) {
+            if (table.contains(symbol)) checksum_map += table.GetAddress(symbol);
+            else checksum_map += table.addVariable(symbol);
+        }
+    });
+
+    long long checksum_hash = 0;
+    double hash_seconds = measure([&]() {
+        SymbolTable table;
+        for (int i = 0; i < labels; ++i) table.addEntry(definitions[i], i);
+        for (const std::string& symbol : references) {
+            int id = table.findOrInsert(symbol);
+            if (table.isDefined(id)) checksum_hash += table.addressOf(id);
+            else checksum_hash += table.addVariable(id);
+        }
+    });
+
+    double operations = static_cast<double>(labels + references.size());
+    std::cout << "labels: " << labels << ", symbol uses: " << references.size() << std::endl;
+    std::cout << "std::map table:      " << operations / map_seconds / 1e6 << " M operations/sec" << std::endl;
+    std::cout << "open addressing:     " << operations / hash_seconds / 1e6 << " M operations/sec" << std::endl;
+    std::cout << "speedup: " << map_seconds / hash_seconds << "x"
+              << ((checksum_map == checksum_hash) ? "" : " (CHECKSUM MISMATCH)") << std::endl;
+    return 0;
+}
\ No newline at end of file
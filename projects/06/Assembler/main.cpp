@@ -5,26 +5,97 @@
     - Parser: After parsing, access to each field is provided.
     - Code: Returns the binary code for the association symbol.
     - SymbolTable: Symbol table creation and symbol processing are performed.
+    - Linker: Links relocatable objects(.hobj) into one .hack file.
+    - Optimizer: Peephole rewrites over commands(-O).
 
     Process
+    0. Symbol-free fast path: commands are encoded in one pass until a label or symbol is found.
+       A program without them(ex. MaxL.asm) is done here, without symbol table.
     1. Initialization: Process declaration symbols.
     2. 1PASS: A symbol table is configured for a label(pseudo code).
     3. 2PASS: Translate each command into binary code.
+    (--single-pass: 1PASS and 2PASS are merged. Forward references are patched at the end.)
+    (--threads=N: Commands are read once, and encoded by N threads. N=0 uses all hardware threads.)
+    (--incremental: Regions between labels are cached in .hack.cache, and only changed regions are encoded again.)
+    (--stats[=json]: Print time of each phase(parse, labels, optimize, encode, write, flush) and counters.)
+    (--map: Write an address/source map(.hmap) with the line, label and VM function of each ROM address.)
+    (-O: Commands are rewritten by Optimizer before 2PASS, and labels get their new addresses. Saved words are reported.
+         Code moves, so a program must jump to labels. "@number" just before a jump turns -O off, but a number
+         which reaches a jump through a register(ex. @100, D=A, @R13, M=D ... @R13, A=M, 0;JMP) breaks.)
+
+    Separate assembly
+    - --object: Write a relocatable object(.hobj) instead of .hack.
+    - --link output objectPaths...: Link objects in the given order into output(.hack).
+
+    Streaming
+    - filePath "-": Read .asm from stdin, and write .hack to stdout in one pass.
+      Errors are written to stderr, so the output can be piped.
+      The output is the same as file mode. Words are kept only while a forward reference is unresolved(see Assembler.h).
+      prompt> cat Prog.asm | Assembler --format=bin - > Prog.hack
+
+    Output format
+    - --format=text(default): one "0101..." line per instruction.
+    - --format=bin: raw little-endian 16bit words. It can be mapped directly by emulators.
+
+    Errors
+    - Errors are written to stderr, and the exit status is 1.
+    - An invalid command doesn't stop translation, so every error is reported at once,
+      but no .hack file is left(a stream stops at the error, so check the exit status).
 
     How to use
-    prompt> Assembler filePath
+    prompt> Assembler [-O] [--stats[=json]] [--map] [--single-pass] [--threads=N] [--incremental] [--object] [--format=text|bin] filePath
+    prompt> Assembler [--format=text|bin] - < input.asm > output.hack
+    prompt> Assembler --link [--format=text|bin] output.hack a.hobj b.hobj ...
 */
 
 #include "Global.h"
 #include "Assembler.h"
+#include "Linker.h"
 
 int main(int argc, char* argv[]) {
     try {
-        Assembler assembler(argv[1]);
+        std::string path = "";
+        AssemblerOption option;
+        bool link = false;
+        std::vector<std::string> objects;
+        for (int i = 1; i < argc; ++i) {
+            std::string arg = argv[i];
+            if (arg == "--single-pass") option.single_pass = true;
+            else if (arg == "--format=text") option.format = OutputFormat::text;
+            else if (arg == "--format=bin") option.format = OutputFormat::binary;
+            else if (arg == "--incremental") option.incremental = true;
+            else if (arg == "--object") option.object = true;
+            else if (arg == "-O") option.optimize = true;
+            else if (arg == "--map") option.map = true;
+            else if (arg == "--stats") option.stats = StatsFormat::text;
+            else if (arg == "--stats=json") option.stats = StatsFormat::json;
+            else if (arg == "--link") link = true;
+            else if (arg.rfind("--threads=", 0) == 0) option.threads = std::stoi(arg.substr(10));
+            else if (link && !path.empty()) objects.push_back(arg);
+            else path = arg;
+        }
+        if (path == "-") {
+            std::ios::sync_with_stdio(false);
+            Assembler assembler(std::cin, std::cout, option);
+            assembler.translate();
+            for (const Diagnostic& diagnostic : assembler.diagnostics()) std::cerr << diagnostic.message << std::endl;
+            return assembler.diagnostics().empty() ? 0 : 1;
+        }
+        if (link) {
+            Linker linker(objects, path, option);
+            linker.link();
+            return 0;
+        }
+        Assembler assembler(path, option);
         assembler.translate();
+        for (const Diagnostic& diagnostic : assembler.diagnostics()) std::cerr << diagnostic.message << std::endl;
+        if (option.optimize && !option.incremental && !option.object)
+            std::cout << "Optimizer: " << assembler.savedWords() << " words saved." << std::endl;
+        if (option.stats != StatsFormat::none && !option.incremental && !option.object)
+            assembler.stats().print(std::cout, option.stats);
+        return assembler.diagnostics().empty() ? 0 : 1;
     } catch (std::exception& e) {
-        std::cout << e.what() << std::endl;
+        std::cerr << e.what() << std::endl;
+        return 1;
     }
-
-    return 0;
-}
\ No newline at end of file
+}
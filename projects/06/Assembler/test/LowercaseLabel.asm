@@ -0,0 +1,28 @@
+// File name: projects/06/Assembler/test/LowercaseLabel.asm
+
+// Streaming(filePath "-") must write the same words as file mode.
+// "Assembler - < LowercaseLabel.asm" and "Assembler LowercaseLabel.asm" both give LowercaseLabel.hack.
+// loop and done are lowercase labels used before their definitions, so they are forward
+// references, not variables. i is a variable used before the static Main.0, so Main.0 is
+// allocated after i(RAM[17]), although a static is otherwise allocated at its first use.
+
+    @i
+    M=1
+    @Main.0
+    M=0
+(loop)
+    @i
+    D=M
+    @Main.0
+    M=D+M
+    @i
+    MD=M+1
+    @11
+    D=D-A
+    @done
+    D;JGT
+    @loop
+    0;JMP
+(done)
+    @done
+    0;JMP
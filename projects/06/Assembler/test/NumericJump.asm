@@ -0,0 +1,24 @@
+// File name: projects/06/Assembler/test/NumericJump.asm
+
+// A program which jumps to a numeric address must pass -O unchanged(Optimizer.h).
+// NumericJump.hack is the output of "Assembler -O NumericJump.asm".
+// "@10; 0;JMP" skips the two stores in front of (STORE). Removing them as unreachable
+// would move STORE to address 6, and the jump would land in END instead,
+// so RAM[1] would stay 0.
+
+    @5
+    D=A
+    @R0
+    M=D
+    @10         // STORE
+    0;JMP
+    @R0
+    M=0
+    @R1
+    M=0
+(STORE)
+    @R1
+    M=D
+(END)
+    @END
+    0;JMP
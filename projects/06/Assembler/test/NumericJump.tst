@@ -0,0 +1,13 @@
+// File name: projects/06/Assembler/test/NumericJump.tst
+
+load NumericJump.hack,
+output-file NumericJump.out,
+compare-to NumericJump.cmp,
+output-list RAM[0]%D2.6.2 RAM[1]%D2.6.2;
+
+set RAM[0] 0,
+set RAM[1] 0;
+repeat 20 {
+  ticktock;
+}
+output;
@@ -0,0 +1,20 @@
+/**
+    Implementation of AsmFile.h
+*/
+
+#include "AsmFile.h"
+#include "../Assembler/Assembler.h"
+
+std::vector<uint16_t> assembleFile(const std::string& path) {
+    std::ifstream input(path, std::ios::in | std::ios::binary);
+    if (input.fail()) throw fileException(path);
+    std::string source((std::istreambuf_iterator<char>(input)), std::istreambuf_iterator<char>());
+
+    AssembleResult result = assemble(source);
+    if (!result.diagnostics.empty()) {
+        std::string message = path + ": " + result.diagnostics.front().message;
+        if (result.diagnostics.size() > 1) message += "(and " + std::to_string(result.diagnostics.size() - 1) + " more)";
+        throw std::runtime_error(message);
+    }
+    return result.words;
+}
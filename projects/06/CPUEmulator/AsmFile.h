@@ -0,0 +1,20 @@
+/**
+    AsmFile Module
+    Loads a .asm program by assembling it in memory with the 06 Assembler(assemble() of Assembler.h),
+    so a test script which loads Prog.asm doesn't depend on a Prog.hack built before.
+
+    Routines
+    - assembleFile(path): return the words. A file error or an assembler diagnostic
+                          throws std::runtime_error with the messages.
+*/
+
+#ifndef __ASM_FILE_H__
+#define __ASM_FILE_H__
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+std::vector<uint16_t> assembleFile(const std::string& path);
+
+#endif
@@ -0,0 +1,105 @@
+/**
+    Implementation of Batch.h
+*/
+
+#include "Batch.h"
+#include <atomic>
+#include <chrono>
+#include <sstream>
+#include <thread>
+#include "Runner.h"
+
+namespace {
+    struct Job {
+        std::string line;
+        RunOption option;
+        std::string error;          // of parsing
+        bool passed;
+        double seconds;
+        std::string output;
+    };
+
+    std::vector<Job> readJobs(const std::string& path) {
+        std::ifstream input(path);
+        if (input.fail()) throw fileException(path);
+
+        std::vector<Job> jobs;
+        for (std::string line; std::getline(input, line); ) {
+            if (!line.empty() && line.back() == '\r') line.pop_back();
+            std::stringstream words(line);
+            std::vector<std::string> args;
+            for (std::string word; words >> word; ) args.push_back(word);
+            if (args.empty() || args[0][0] == '#') continue;
+
+            Job job{line, RunOption(), "", false, 0, ""};
+            try {
+                job.option = parseRunOption(args);
+            } catch (std::exception& e) {
+                job.error = e.what();
+            }
+            jobs.push_back(job);
+        }
+        return jobs;
+    }
+
+    void runOne(Job& job) {
+        if (!job.error.empty()) {
+            job.output = job.error + "\n";
+            return;
+        }
+        std::ostringstream output;
+        auto start = std::chrono::steady_clock::now();
+        try {
+            job.passed = (runJob(job.option, output) == 0);
+        } catch (std::exception& e) {
+            output << e.what() << std::endl;
+        }
+        job.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        job.output = output.str();
+    }
+}
+
+int runBatch(const std::string& path, std::size_t threads, std::ostream& output) {
+    std::vector<Job> jobs = readJobs(path);
+
+    /* The longest jobs(by --cycles) first. A test script runs its own count, so it goes last. */
+    std::vector<std::size_t> order(jobs.size());
+    for (std::size_t i = 0; i < order.size(); ++i) order[i] = i;
+    auto budget = [&](std::size_t i) -> uint64_t {
+        const std::string& job_path = jobs[i].option.path;
+        bool script = job_path.size() > 4 && job_path.compare(job_path.size() - 4, 4, ".tst") == 0;
+        return script ? 0 : jobs[i].option.cycles;
+    };
+    std::stable_sort(order.begin(), order.end(), [&](std::size_t a, std::size_t b) { return budget(a) > budget(b); });
+
+    std::atomic<std::size_t> next_job(0);
+    auto worker = [&]() {
+        for (std::size_t i = next_job++; i < order.size(); i = next_job++) runOne(jobs[order[i]]);
+    };
+
+    std::size_t thread_count = (threads > 0) ? threads : std::max(1u, std::thread::hardware_concurrency());
+    thread_count = std::min(thread_count, std::max<std::size_t>(jobs.size(), 1));
+    auto start = std::chrono::steady_clock::now();
+    {
+        std::vector<std::thread> pool;
+        for (std::size_t i = 1; i < thread_count; ++i) pool.emplace_back(worker);
+        worker();
+        for (std::thread& thread : pool) thread.join();
+    }
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    std::size_t passed = 0;
+    double job_seconds = 0;
+    for (const Job& job : jobs) {
+        if (job.passed) ++passed;
+        job_seconds += job.seconds;
+        output << (job.passed ? "[PASS] " : "[FAIL] ") << job.seconds * 1000 << " ms: " << job.line << std::endl;
+        std::stringstream lines(job.output);
+        for (std::string line; std::getline(lines, line); ) output << "    " << line << std::endl;
+    }
+    output << "Jobs: " << jobs.size() << ", passed: " << passed << ", failed: " << jobs.size() - passed
+           << " (" << thread_count << " threads)" << std::endl;
+    output << "Wall time " << seconds * 1000 << " ms, job time " << job_seconds * 1000 << " ms("
+           << (seconds > 0 ? job_seconds / seconds : 0) << "x)" << std::endl;
+    return (passed == jobs.size()) ? 0 : 1;
+}
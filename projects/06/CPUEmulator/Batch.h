@@ -0,0 +1,34 @@
+/**
+    Batch Module
+    Runs many emulator jobs(Runner.h) at once on a pool of threads(--batch), as a regression run.
+
+    Job file
+    - one job per line: options and filePath, as the command line of one run
+      ex. "--cycles=5000000 --keys=Pong.keys --print=0 Pong.hack", "Mult.tst"
+    - blank lines and lines starting with '#' are skipped.
+    - paths are relative to the current directory.
+
+    Scheduling
+    - Every job has its own CPU, profiler and report, so jobs share nothing but the job list.
+    - Threads take the next job from a shared counter, so a thread which finishes early
+      takes more jobs. Jobs with the largest --cycles go first, so a long job doesn't start last.
+    - The wall time is about the time of the longest job, not the sum of all jobs.
+
+    Report
+    - "[PASS]" or "[FAIL]", time and line of each job in job file order, followed by its output.
+      A job fails if it throws or returns a nonzero status(ex. a comparison failure).
+    - a summary: jobs, passed, failed, wall time, and the summed job time(and its ratio to the wall time).
+
+    Routines
+    - runBatch(path, threads, output): run the jobs of the job file on threads(0: hardware threads),
+                                       write the report to output, and return 1 if any job failed.
+*/
+
+#ifndef __BATCH_H__
+#define __BATCH_H__
+
+#include "Global.h"
+
+int runBatch(const std::string& path, std::size_t threads, std::ostream& output);
+
+#endif
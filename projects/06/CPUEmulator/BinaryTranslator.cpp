@@ -0,0 +1,216 @@
+/**
+    Implementation of BinaryTranslator.h
+*/
+
+#include "BinaryTranslator.h"
+#include <sstream>
+
+namespace {
+    const char* PROLOGUE = R"CPP(// Generated by CPUEmulator --translate. Do not edit.
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+static int16_t RAM[32768];
+)CPP";
+
+    /* Only for a computation without a named ALU function. */
+    const char* ALU_FUNCTION = R"CPP(
+static int16_t alu(int control, int16_t x, int16_t y) {
+    if (control & 0x20) x = 0;
+    if (control & 0x10) x = ~x;
+    if (control & 0x08) y = 0;
+    if (control & 0x04) y = ~y;
+    int16_t out = (control & 0x02) ? static_cast<int16_t>(x + y) : static_cast<int16_t>(x & y);
+    return (control & 0x01) ? static_cast<int16_t>(~out) : out;
+}
+)CPP";
+
+    const char* RUN = R"CPP(
+static uint64_t run(uint64_t limit, uint32_t& pc, bool& halted) {
+    [[maybe_unused]] int16_t A = 0, D = 0, o = 0, j = 0;
+    uint64_t cycles = 0;
+    halted = false;
+    goto L0;
+)CPP";
+
+    const char* EPILOGUE = R"CPP(
+int main(int argc, char* argv[]) {
+    uint64_t cycles = 100000000;
+    std::vector<int> prints;
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg.rfind("--cycles=", 0) == 0) {
+            cycles = std::stoull(arg.substr(9));
+        } else if (arg.rfind("--set=", 0) == 0) {
+            std::size_t equal = arg.find('=', 6);
+            RAM[std::stoi(arg.substr(6, equal - 6)) & 0x7fff] = static_cast<int16_t>(std::stoi(arg.substr(equal + 1)));
+        } else if (arg.rfind("--print=", 0) == 0) {
+            std::stringstream list(arg.substr(8));
+            for (std::string address; std::getline(list, address, ','); ) prints.push_back(std::stoi(address));
+        }
+    }
+
+    uint32_t pc = 0;
+    bool halted = false;
+    auto start = std::chrono::steady_clock::now();
+    uint64_t executed = run(cycles, pc, halted);
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    std::cout << "Executed " << executed << " instructions in " << seconds * 1000 << " ms("
+              << (seconds > 0 ? executed / seconds / 1e6 : 0) << " M instructions/sec)"
+              << (halted ? ", halted at PC " + std::to_string(pc) : "") << std::endl;
+    for (int address : prints) std::cout << "RAM[" << address << "] = " << RAM[address & 0x7fff] << std::endl;
+    return 0;
+}
+)CPP";
+
+    const char* CONDITION[] = {"", "o > 0", "o == 0", "o >= 0", "o < 0", "o != 0", "o <= 0", "true"};
+}
+
+/* =========== PRIVATE ============= */
+
+void BinaryTranslator::findLeaders() {
+    const std::size_t size = ops_.size();
+    leaders_.assign(size + 1, false);
+    leaders_[0] = true;
+    leaders_[size] = true;
+    for (std::size_t i = 0; i < size; ++i) {
+        const MicroOp& op = ops_[i];
+        if (op.alu == ALU::LOAD && op.value < size) leaders_[op.value] = true;
+        else if (op.alu != ALU::LOAD && op.jump != 0) leaders_[i + 1] = true;
+    }
+}
+
+std::string BinaryTranslator::expression(const MicroOp& op) const {
+    switch (op.alu) {
+        case ALU::ZERO:       return "0";
+        case ALU::ONE:        return "1";
+        case ALU::MINUS_ONE:  return "-1";
+        case ALU::D:          return "D";
+        case ALU::A:          return "A";
+        case ALU::M:          return "RAM[A & 0x7fff]";
+        case ALU::NOT_D:      return "~D";
+        case ALU::NOT_A:      return "~A";
+        case ALU::NOT_M:      return "~RAM[A & 0x7fff]";
+        case ALU::NEG_D:      return "-D";
+        case ALU::NEG_A:      return "-A";
+        case ALU::NEG_M:      return "-RAM[A & 0x7fff]";
+        case ALU::D_PLUS_1:   return "D + 1";
+        case ALU::A_PLUS_1:   return "A + 1";
+        case ALU::M_PLUS_1:   return "RAM[A & 0x7fff] + 1";
+        case ALU::D_MINUS_1:  return "D - 1";
+        case ALU::A_MINUS_1:  return "A - 1";
+        case ALU::M_MINUS_1:  return "RAM[A & 0x7fff] - 1";
+        case ALU::D_PLUS_A:   return "D + A";
+        case ALU::D_PLUS_M:   return "D + RAM[A & 0x7fff]";
+        case ALU::D_MINUS_A:  return "D - A";
+        case ALU::D_MINUS_M:  return "D - RAM[A & 0x7fff]";
+        case ALU::A_MINUS_D:  return "A - D";
+        case ALU::M_MINUS_D:  return "RAM[A & 0x7fff] - D";
+        case ALU::D_AND_A:    return "D & A";
+        case ALU::D_AND_M:    return "D & RAM[A & 0x7fff]";
+        case ALU::D_OR_A:     return "D | A";
+        case ALU::D_OR_M:     return "D | RAM[A & 0x7fff]";
+        case ALU::GENERIC_A:  return "alu(" + std::to_string(op.value) + ", D, A)";
+        case ALU::GENERIC_M:  return "alu(" + std::to_string(op.value) + ", D, RAM[A & 0x7fff])";
+        default:              return "0";
+    }
+}
+
+void BinaryTranslator::writeBlock(std::ostream& output, std::size_t begin, std::size_t end) {
+    const std::size_t size = ops_.size();
+    output << "    if (cycles + " << (end - begin) << " > limit) { pc = " << begin << "; return cycles; }\n"
+           << "    cycles += " << (end - begin) << ";\n";
+
+    /* A known while the block has loaded a constant and not written A. */
+    int known = -1;
+    for (std::size_t i = begin; i < end; ++i) {
+        const MicroOp& op = ops_[i];
+        if (op.alu == ALU::LOAD) {
+            output << "    A = " << op.value << ";\n";
+            known = op.value;
+            continue;
+        }
+
+        output << "    o = static_cast<int16_t>(" << expression(op) << ");";
+        if (op.jump != 0 && known < 0) output << " j = A;";
+        if (op.dest & Dest::M) output << " RAM[A & 0x7fff] = o;";
+        if (op.dest & Dest::A) output << " A = o;";
+        if (op.dest & Dest::D) output << " D = o;";
+        if (op.jump != 0) {
+            output << " if (" << CONDITION[op.jump] << ") ";
+            if (known < 0) {
+                output << "{ pc = j & 0x7fff; goto dispatch; }";
+                dispatch_ = true;
+            } else if (static_cast<std::size_t>(known) < size) {
+                output << "goto L" << known << ";";
+                targets_[known] = true;
+            } else {
+                output << "{ pc = " << known << "; goto halt; }";
+                halt_ = true;
+            }
+        }
+        output << "\n";
+        if (op.dest & Dest::A) known = -1;
+    }
+}
+
+/* =========== PUBLIC ============= */
+
+void BinaryTranslator::translate(const std::vector<uint16_t>& words, const std::string& path) {
+    ops_.resize(words.size());
+    std::transform(words.begin(), words.end(), ops_.begin(), decode);
+    findLeaders();
+
+    /* Blocks are written first, so only labels which are jumped to are emitted(-Wall clean). */
+    const std::size_t size = ops_.size();
+    targets_.assign(size + 1, false);
+    targets_[0] = true;
+    dispatch_ = false;
+    halt_ = false;
+    std::vector<std::pair<std::size_t, std::string>> blocks;
+    for (std::size_t begin = 0; begin < size; ) {
+        std::size_t end = begin + 1;
+        while (!leaders_[end]) ++end;
+        std::ostringstream block;
+        writeBlock(block, begin, end);
+        blocks.push_back({begin, block.str()});
+        begin = end;
+    }
+    if (dispatch_) {
+        for (std::size_t address = 0; address < size; ++address) targets_[address] = targets_[address] || leaders_[address];
+        halt_ = true;
+    }
+    bool generic = std::any_of(ops_.begin(), ops_.end(), [](const MicroOp& op) { return op.alu == ALU::GENERIC_A || op.alu == ALU::GENERIC_M; });
+
+    std::ofstream output(path);
+    if (output.fail()) throw fileException(path);
+    output << PROLOGUE << (generic ? ALU_FUNCTION : "") << RUN;
+    for (const auto& block : blocks) {
+        if (targets_[block.first]) output << "L" << block.first << ":\n";
+        output << block.second;
+    }
+
+    output << "    pc = " << size << ";\n"
+           << (halt_ ? "halt:\n" : "")
+           << "    halted = true;\n"
+           << "    return cycles;\n";
+    if (dispatch_) {
+        output << "dispatch:\n"
+               << "    switch (pc) {\n";
+        for (std::size_t address = 0; address < size; ++address) {
+            if (leaders_[address]) output << "        case " << address << ": goto L" << address << ";\n";
+        }
+        output << "        default:\n"
+               << "            if (pc >= " << size << ") goto halt;\n"
+               << "            std::cerr << \"Jump to " << "PC \" << pc << \" which isn't a block start.\" << std::endl;\n"
+               << "            return cycles;\n"
+               << "    }\n";
+    }
+    output << "}\n"
+           << EPILOGUE;
+}
@@ -0,0 +1,49 @@
+/**
+    BinaryTranslator Module(Class)
+    Translates a .hack program to C++ source, which is compiled by the host compiler
+    into a native program with the same RAM semantics as CPU.
+
+    Basic blocks
+    - A block starts at address 0, at every jump target, after every jump,
+      and at every A-Command constant inside the program(a possible computed target,
+      ex. "@RETURN3, D=A" pushes a return address).
+    - Each block is straight-line C++. Only a block which is jumped to has a label(L<address>),
+      and alu() is only written when a computation needs it, so the source is -Wall clean.
+      The cycle counter is advanced once per block, and the run stops when it passes --cycles.
+    - A jump to a known constant("@LOOP, 0;JMP") is a direct goto.
+      Any other jump("@R15, A=M, 0;JMP" return) goes through a switch(jump table) over block starts.
+      A computed jump to an address which isn't a block start stops the program with an error.
+
+    Generated program
+    prompt> g++ -O2 out.cpp -o out
+    prompt> out [--cycles=N] [--set=address=value]... [--print=address,...]
+    (Same options and output as CPUEmulator.)
+
+    Routines
+    - translate(words, path): write C++ source of the program to path.
+*/
+
+#ifndef __BINARY_TRANSLATOR_H__
+#define __BINARY_TRANSLATOR_H__
+
+#include "Global.h"
+#include "MicroOp.h"
+
+class BinaryTranslator {
+private:
+    std::vector<MicroOp> ops_;
+    std::vector<bool> leaders_;
+    std::vector<bool> targets_;     // blocks which are jumped to(need a label)
+    bool dispatch_;                 // a computed jump needs the switch
+    bool halt_;                     // halt is jumped to
+
+private:
+    void findLeaders();
+    std::string expression(const MicroOp& op) const;
+    void writeBlock(std::ostream& output, std::size_t begin, std::size_t end);
+
+public:
+    void translate(const std::vector<uint16_t>& words, const std::string& path);
+};
+
+#endif
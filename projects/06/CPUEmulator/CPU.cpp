@@ -0,0 +1,214 @@
+/**
+    Implementation of CPU.h
+*/
+
+#include "CPU.h"
+#include "Fusion.h"
+#include "Profiler.h"
+
+/* =========== PRIVATE ============= */
+
+/* Called at each visit of a loop head. Returns the number of instructions to skip. */
+uint64_t CPU::idle(IdleLoop& loop, int16_t a, int16_t d, uint64_t executed, uint64_t cycles) {
+    bool unchanged = loop.visited && loop.cycle + loop.length == executed && loop.a == a && loop.d == d;
+    bool saved = loop.saved;
+    loop.visited = true;
+    loop.saved = false;
+    loop.a = a;
+    loop.d = d;
+    loop.cycle = executed;
+    if (!unchanged) return 0;
+
+    if (loop.check_ram) {
+        if (!saved) {
+            loop.ram = ram_;
+            loop.saved = true;
+            return 0;
+        }
+        if (loop.ram != ram_) {
+            rom_[loop.head] = loop.op;
+            return 0;
+        }
+    }
+
+    /* Leave at least one instruction, so the caller executes the op at head. */
+    uint64_t skip = (cycles - executed - 1) / loop.length * loop.length;
+    loop.cycle += skip;
+    idle_pc_ = loop.head;
+    idle_cycles_ += skip;
+    return skip;
+}
+
+/* PROFILE runs single-word ops only, and calls profiler before each instruction. */
+template <bool PROFILE>
+uint64_t CPU::execute(uint64_t cycles, Profiler* profiler) {
+    const MicroOp* rom = PROFILE ? plain_.data() : rom_.data();
+    const MicroOp* plain = plain_.data();
+    int16_t* ram = ram_.data();
+    uint32_t pc = pc_;
+    int16_t a = a_;
+    int16_t d = d_;
+    uint64_t executed = 0;
+    uint64_t fused = 0;
+    /* A superinstruction runs only if its whole length fits in cycles, so cycles stays exact. */
+    const uint64_t fused_end = (cycles >= MAX_FUSED_LENGTH) ? cycles - MAX_FUSED_LENGTH + 1 : 0;
+
+    for (IdleLoop& loop : idle_loops_) loop.visited = false;
+
+    for (; executed < cycles; ++executed) {
+        MicroOp op = (executed < fused_end) ? rom[pc] : plain[pc];
+        if constexpr (PROFILE) {
+            if (op.alu == ALU::HALT) goto halt;
+            profiler->instruction(static_cast<uint16_t>(pc));
+        }
+        int16_t out;
+dispatch:
+        switch (op.alu) {
+            case ALU::LOAD:       a = static_cast<int16_t>(op.value); ++pc; continue;
+            case ALU::ZERO:       out = 0; break;
+            case ALU::ONE:        out = 1; break;
+            case ALU::MINUS_ONE:  out = -1; break;
+            case ALU::D:          out = d; break;
+            case ALU::A:          out = a; break;
+            case ALU::M:          out = ram[a & 0x7fff]; break;
+            case ALU::NOT_D:      out = ~d; break;
+            case ALU::NOT_A:      out = ~a; break;
+            case ALU::NOT_M:      out = ~ram[a & 0x7fff]; break;
+            case ALU::NEG_D:      out = -d; break;
+            case ALU::NEG_A:      out = -a; break;
+            case ALU::NEG_M:      out = -ram[a & 0x7fff]; break;
+            case ALU::D_PLUS_1:   out = d + 1; break;
+            case ALU::A_PLUS_1:   out = a + 1; break;
+            case ALU::M_PLUS_1:   out = ram[a & 0x7fff] + 1; break;
+            case ALU::D_MINUS_1:  out = d - 1; break;
+            case ALU::A_MINUS_1:  out = a - 1; break;
+            case ALU::M_MINUS_1:  out = ram[a & 0x7fff] - 1; break;
+            case ALU::D_PLUS_A:   out = d + a; break;
+            case ALU::D_PLUS_M:   out = d + ram[a & 0x7fff]; break;
+            case ALU::D_MINUS_A:  out = d - a; break;
+            case ALU::D_MINUS_M:  out = d - ram[a & 0x7fff]; break;
+            case ALU::A_MINUS_D:  out = a - d; break;
+            case ALU::M_MINUS_D:  out = ram[a & 0x7fff] - d; break;
+            case ALU::D_AND_A:    out = d & a; break;
+            case ALU::D_AND_M:    out = d & ram[a & 0x7fff]; break;
+            case ALU::D_OR_A:     out = d | a; break;
+            case ALU::D_OR_M:     out = d | ram[a & 0x7fff]; break;
+            case ALU::GENERIC_A:  out = computeALU(op.value, d, a); break;
+            case ALU::GENERIC_M:  out = computeALU(op.value, d, ram[a & 0x7fff]); break;
+            case ALU::PUSH_D:
+                a = ram[op.value];
+                ram[a & 0x7fff] = d;
+                ++ram[op.value];
+                a = static_cast<int16_t>(op.value);
+                goto fused;
+            case ALU::PUSH_D_PRE:
+                a = static_cast<int16_t>(++ram[op.value] - 1);
+                ram[a & 0x7fff] = d;
+                goto fused;
+            case ALU::POP_D:
+                a = --ram[op.value];
+                d = ram[a & 0x7fff];
+                goto fused;
+            case ALU::POP_A:
+                a = --ram[op.value];
+                a = ram[a & 0x7fff];
+                goto fused;
+            case ALU::LOAD_D_M:   a = static_cast<int16_t>(op.value); d = ram[op.value]; goto fused;
+            case ALU::LOAD_D_A:   a = d = static_cast<int16_t>(op.value); goto fused;
+            case ALU::STORE_D:    a = static_cast<int16_t>(op.value); ram[op.value] = d; goto fused;
+            case ALU::LOAD_A_M:   a = ram[op.value]; goto fused;
+            case ALU::INC_M:      a = static_cast<int16_t>(op.value); ++ram[op.value]; goto fused;
+            case ALU::DEC_M:      a = static_cast<int16_t>(op.value); --ram[op.value]; goto fused;
+            case ALU::SEGMENT:
+                d = ram[op.value];
+                a = static_cast<int16_t>(d + static_cast<int16_t>(op.operand));
+                goto fused;
+            case ALU::JUMP:
+                a = static_cast<int16_t>(op.value);
+                pc = op.value;
+                executed += 1;
+                fused += 2;
+                continue;
+            case ALU::JUMP_IF_D:
+                a = static_cast<int16_t>(op.value);
+                pc = (op.jump & jumpClass(d)) ? op.value : pc + 2;
+                executed += 1;
+                fused += 2;
+                continue;
+            case ALU::IDLE: {
+                IdleLoop& loop = idle_loops_[op.value];
+                executed += idle(loop, a, d, executed, cycles);
+                op = (executed < fused_end) ? loop.op : plain[pc];
+                goto dispatch;
+            }
+            default:              goto halt;    // HALT
+        }
+
+        {
+            const int16_t address = a;
+            if (op.dest & Dest::M) ram[address & 0x7fff] = out;
+            if (op.dest & Dest::A) a = out;
+            if (op.dest & Dest::D) d = out;
+            pc = (op.jump & jumpClass(out)) ? (address & 0x7fff) : pc + 1;
+        }
+        continue;
+fused:
+        pc += op.length;
+        executed += op.length - 1;
+        fused += op.length;
+    }
+halt:
+    pc_ = static_cast<uint16_t>(pc);
+    a_ = a;
+    d_ = d;
+    cycles_ += executed;
+    fused_cycles_ += fused;
+    return executed;
+}
+
+/* =========== PUBLIC ============= */
+
+CPU::CPU() : rom_(ROM_SIZE + 1, HALT_OP), plain_(ROM_SIZE + 1, HALT_OP), ram_(RAM_SIZE, 0), program_size_(0) {
+    reset();
+}
+
+void CPU::load(const std::vector<uint16_t>& words, bool fusion, bool idle) {
+    if (words.size() > ROM_SIZE) throw loadException("program is larger than ROM");
+    std::fill(plain_.begin(), plain_.end(), HALT_OP);
+    std::transform(words.begin(), words.end(), plain_.begin(), decode);
+    rom_ = plain_;
+    if (fusion) {
+        for (std::size_t address = 0; address < words.size(); ++address) rom_[address] = fuse(words, address);
+    }
+    idle_loops_.clear();
+    if (idle) idle_loops_ = findIdleLoops(words);
+    for (std::size_t i = 0; i < idle_loops_.size(); ++i) {
+        IdleLoop& loop = idle_loops_[i];
+        loop.op = rom_[loop.head];
+        rom_[loop.head] = {ALU::IDLE, 0, 0, 1, static_cast<uint16_t>(i), 0};
+    }
+    program_size_ = words.size();
+    reset();
+}
+
+void CPU::reset() {
+    pc_ = 0;
+    a_ = 0;
+    d_ = 0;
+    cycles_ = 0;
+    fused_cycles_ = 0;
+    idle_pc_ = -1;
+    idle_cycles_ = 0;
+}
+
+void CPU::clearRAM() {
+    std::fill(ram_.begin(), ram_.end(), 0);
+}
+
+uint64_t CPU::run(uint64_t cycles) {
+    return execute<false>(cycles, nullptr);
+}
+
+uint64_t CPU::profile(uint64_t cycles, Profiler& profiler) {
+    return execute<true>(cycles, &profiler);
+}
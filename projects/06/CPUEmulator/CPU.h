@@ -0,0 +1,90 @@
+/**
+    CPU Module(Class)
+    Hack CPU emulator over pre-decoded micro-ops(MicroOp.h).
+
+    Routines
+    - load(words, fusion, idle): decode a program into ROM, and reset.
+                                 With fusion, idioms are also fused into superinstructions(Fusion.h).
+                                 With idle, idle loops are fast-forwarded.
+    - reset: PC, A and D are 0. RAM is kept, same as the Reset button of CPUEmulator.
+    - clearRAM
+    - run(cycles): execute at most cycles instructions, and return the number executed.
+                   It stops early if PC leaves the program(HALT).
+    - profile(cycles, profiler): same as run, but every instruction is single-word and
+                                 counted by profiler(Profiler.h). Idle loops aren't skipped.
+    - ram(address), ram(): flat 32K RAM. SCREEN and KBD are its parts.
+    - pc, a, d, cycles(total executed), halted
+    - setPC, setA, setD, setCycles: change the state between runs(test scripts, snapshots).
+    - fusedCycles: instructions executed inside superinstructions.
+    - idlePC: head of the last idle loop fast-forwarded by run, or -1.
+    - idleCycles: instructions skipped by fast-forward(counted in cycles).
+
+    Fusion
+    - rom_ has the superinstruction of each address, and plain_ has the single-word op.
+      The last MAX_FUSED_LENGTH cycles of a run use plain_, so run stops exactly at cycles.
+
+    Idle loops
+    - The head of each idle loop candidate is an IDLE op in rom_. When the loop turns out
+      to be at a fixed point, run skips to the end of cycles(IdleLoop.h).
+
+    Semantics
+    - M is RAM[A & 0x7fff]. A jump goes to A before the instruction writes A,
+      same as the CPU chip(PC loads the A register output of the same cycle).
+*/
+
+#ifndef __CPU_H__
+#define __CPU_H__
+
+#include "Global.h"
+#include "MicroOp.h"
+#include "IdleLoop.h"
+
+class Profiler;
+
+class CPU {
+private:
+    std::vector<MicroOp> rom_;
+    std::vector<MicroOp> plain_;
+    std::vector<int16_t> ram_;
+    std::size_t program_size_;
+    uint16_t pc_;
+    int16_t a_;
+    int16_t d_;
+    uint64_t cycles_;
+    uint64_t fused_cycles_;
+    std::vector<IdleLoop> idle_loops_;
+    int32_t idle_pc_;
+    uint64_t idle_cycles_;
+
+private:
+    uint64_t idle(IdleLoop& loop, int16_t a, int16_t d, uint64_t executed, uint64_t cycles);
+    template <bool PROFILE> uint64_t execute(uint64_t cycles, Profiler* profiler);
+
+public:
+    CPU();
+
+    void load(const std::vector<uint16_t>& words, bool fusion = true, bool idle = true);
+    void reset();
+    void clearRAM();
+    uint64_t run(uint64_t cycles);
+    uint64_t profile(uint64_t cycles, Profiler& profiler);
+
+    int16_t& ram(uint16_t address) { return ram_[address & 0x7fff]; }
+    int16_t* ram() { return ram_.data(); }
+    const int16_t* ram() const { return ram_.data(); }
+    std::size_t programSize() const { return program_size_; }
+    void setPC(uint16_t pc) { pc_ = pc & 0x7fff; }
+    void setA(int16_t a) { a_ = a; }
+    void setD(int16_t d) { d_ = d; }
+    void setCycles(uint64_t cycles) { cycles_ = cycles; }
+    uint16_t pc() const { return pc_; }
+    int16_t a() const { return a_; }
+    int16_t d() const { return d_; }
+    uint64_t cycles() const { return cycles_; }
+    uint64_t fusedCycles() const { return fused_cycles_; }
+    int32_t idlePC() const { return idle_pc_; }
+    uint64_t idleCycles() const { return idle_cycles_; }
+    bool halted() const { return rom_[pc_].alu == ALU::HALT; }
+};
+
+#endif
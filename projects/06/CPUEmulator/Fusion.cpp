@@ -0,0 +1,89 @@
+/**
+    Implementation of Fusion.h
+*/
+
+#include "Fusion.h"
+
+namespace {
+    /* Pattern words. X and Y are A-Command slots, and others are exact C-Command words. */
+    constexpr int32_t X = -1;
+    constexpr int32_t Y = -2;
+    constexpr int32_t END = -3;
+
+    constexpr int32_t A_EQ_M      = 0xfc20;    // A=M
+    constexpr int32_t M_EQ_D      = 0xe308;    // M=D
+    constexpr int32_t M_EQ_M_PLUS = 0xfdc8;    // M=M+1
+    constexpr int32_t M_EQ_M_MINUS = 0xfc88;   // M=M-1
+    constexpr int32_t D_EQ_M      = 0xfc10;    // D=M
+    constexpr int32_t AM_EQ_M_MINUS = 0xfca8;  // AM=M-1
+    constexpr int32_t AM_EQ_M_PLUS = 0xfde8;   // AM=M+1
+    constexpr int32_t A_EQ_A_MINUS = 0xeca0;   // A=A-1
+    constexpr int32_t D_EQ_A      = 0xec10;    // D=A
+    constexpr int32_t A_EQ_D_PLUS_A = 0xe0a0;  // A=D+A
+    constexpr int32_t JMP         = 0xea87;    // 0;JMP
+    constexpr uint16_t D_JUMP     = 0xe300;    // D;J..(jump bits are any but 0)
+
+    struct Pattern {
+        ALU alu;
+        int32_t words[MAX_FUSED_LENGTH + 1];
+    };
+
+    /* Longest first. */
+    const Pattern PATTERNS[] = {
+        {ALU::PUSH_D,   {X, A_EQ_M, M_EQ_D, X, M_EQ_M_PLUS, END}},
+        {ALU::POP_D,    {X, M_EQ_M_MINUS, X, A_EQ_M, D_EQ_M, END}},
+        {ALU::POP_A,    {X, M_EQ_M_MINUS, X, A_EQ_M, A_EQ_M, END}},
+        {ALU::PUSH_D_PRE, {X, AM_EQ_M_PLUS, A_EQ_A_MINUS, M_EQ_D, END}},
+        {ALU::POP_D,    {X, M_EQ_M_MINUS, A_EQ_M, D_EQ_M, END}},
+        {ALU::POP_A,    {X, M_EQ_M_MINUS, A_EQ_M, A_EQ_M, END}},
+        {ALU::SEGMENT,  {X, D_EQ_M, Y, A_EQ_D_PLUS_A, END}},
+        {ALU::POP_D,    {X, AM_EQ_M_MINUS, D_EQ_M, END}},
+        {ALU::POP_A,    {X, AM_EQ_M_MINUS, A_EQ_M, END}},
+        {ALU::LOAD_D_M, {X, D_EQ_M, END}},
+        {ALU::LOAD_D_A, {X, D_EQ_A, END}},
+        {ALU::STORE_D,  {X, M_EQ_D, END}},
+        {ALU::LOAD_A_M, {X, A_EQ_M, END}},
+        {ALU::INC_M,    {X, M_EQ_M_PLUS, END}},
+        {ALU::DEC_M,    {X, M_EQ_M_MINUS, END}},
+        {ALU::JUMP,     {X, JMP, END}}
+    };
+
+    bool isACommand(uint16_t word) {
+        return (word & 0x8000) == 0;
+    }
+
+    /* Returns the length of the match, or 0. */
+    int match(const Pattern& pattern, const std::vector<uint16_t>& words, std::size_t address, MicroOp& op) {
+        int32_t x = -1;
+        int32_t y = -1;
+        int length = 0;
+        for (; pattern.words[length] != END; ++length) {
+            if (address + length >= words.size()) return 0;
+            uint16_t word = words[address + length];
+            int32_t expected = pattern.words[length];
+            if (expected == X || expected == Y) {
+                int32_t& slot = (expected == X) ? x : y;
+                if (!isACommand(word) || (slot >= 0 && slot != word)) return 0;
+                slot = word;
+            } else if (word != expected) {
+                return 0;
+            }
+        }
+        op = {pattern.alu, 0, 0, static_cast<uint8_t>(length), static_cast<uint16_t>(x), static_cast<uint16_t>(y < 0 ? 0 : y)};
+        return length;
+    }
+}
+
+MicroOp fuse(const std::vector<uint16_t>& words, std::size_t address) {
+    MicroOp op = decode(words[address]);
+    for (const Pattern& pattern : PATTERNS) {
+        if (match(pattern, words, address, op) > 0) return op;
+    }
+
+    if (address + 1 < words.size() && isACommand(words[address])) {
+        uint16_t next = words[address + 1];
+        if ((next & 0xfff8) == D_JUMP && (next & 0x7) != 0)
+            return {ALU::JUMP_IF_D, 0, static_cast<uint8_t>(next & 0x7), 2, words[address], 0};
+    }
+    return op;
+}
@@ -0,0 +1,40 @@
+/**
+    Fusion Module
+    Superinstructions for idioms of VMtranslator(CodeWriter) output.
+
+    Idioms(X, Y are A-Command constants. Both X of an idiom must be equal.)
+    - PUSH_D:     @X, A=M, M=D, @X, M=M+1           (push D)
+    - PUSH_D_PRE: @X, AM=M+1, A=A-1, M=D            (push D, as the Pong.hack translator does)
+    - POP_D:      @X, M=M-1, @X, A=M, D=M           (pop to D)
+                  @X, M=M-1, A=M, D=M               (same, after -O)
+                  @X, AM=M-1, D=M
+    - POP_A:      same as POP_D, but the last is A=M(pop to A)
+    - SEGMENT:    @X, D=M, @Y, A=D+A                (segment base + index)
+    - LOAD_D_M:  @X, D=M        - LOAD_D_A:  @X, D=A
+    - STORE_D:   @X, M=D        - LOAD_A_M:  @X, A=M
+    - INC_M:     @X, M=M+1      - DEC_M:     @X, M=M-1
+    - JUMP:      @X, 0;JMP      - JUMP_IF_D: @X, D;J(any condition)
+
+    Rules
+    - The longest idiom which starts at an address is its superinstruction.
+      Only the last word of an idiom may jump, so an idiom never leaves its basic block.
+    - Every address keeps an op, so a jump into the middle of an idiom runs
+      the words(or a shorter idiom) from there.
+    - A superinstruction leaves A, D, RAM and PC exactly as its words do.
+      Reads and writes are done in the same order, so aliasing(ex. X == RAM[X]) is kept.
+
+    Routines
+    - fuse(words, address): return the superinstruction at address, or the plain op.
+*/
+
+#ifndef __FUSION_H__
+#define __FUSION_H__
+
+#include "Global.h"
+#include "MicroOp.h"
+
+constexpr int MAX_FUSED_LENGTH = 5;
+
+MicroOp fuse(const std::vector<uint16_t>& words, std::size_t address);
+
+#endif
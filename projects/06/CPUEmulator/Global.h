@@ -0,0 +1,44 @@
+/**
+    Global Constants and Header, Exception Class
+    fileException is shared with the 06 Assembler(its Global.h), whose modules the emulator links.
+*/
+
+#ifndef __CPU_EMULATOR_GLOBAL_H__
+#define __CPU_EMULATOR_GLOBAL_H__
+
+#include <iostream>
+#include <fstream>
+#include <exception>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <cstdint>
+#include <vector>
+#include <array>
+#include <algorithm>
+#include "../Assembler/Global.h"
+
+/**
+    Hack memory map
+    - ROM: 32K words. PC and jump targets use the low 15 bits of A.
+    - RAM: 32K int16_t words in one flat array.
+           0~16383 data, 16384(SCREEN)~24575 screen, 24576(KBD) keyboard.
+*/
+constexpr std::size_t ROM_SIZE = 0x8000;
+constexpr std::size_t RAM_SIZE = 0x8000;
+constexpr uint16_t SCREEN = 0x4000;
+constexpr uint16_t KBD = 0x6000;
+
+class scriptException : public std::runtime_error {
+public:
+    scriptException(const std::string& path, int line, const std::string& message)
+    : runtime_error("Script Exception: " + message + "(Path: " + path + ", line " + std::to_string(line) + ").") { }
+};
+
+class loadException : public std::runtime_error {
+public:
+    loadException(const std::string& message)
+    : runtime_error("Load Exception: " + message + ".") { }
+};
+
+#endif
@@ -0,0 +1,59 @@
+/**
+    Implementation of HackFile.h
+*/
+
+#include "HackFile.h"
+
+namespace {
+    bool isText(std::string_view buffer) {
+        for (std::size_t position = 0; position < buffer.size(); ) {
+            std::size_t end = buffer.find('\n', position);
+            if (end == std::string_view::npos) end = buffer.size();
+            std::string_view text = buffer.substr(position, end - position);
+            position = end + 1;
+            if (!text.empty() && text.back() == '\r') text.remove_suffix(1);
+            if (text.empty()) continue;
+            if (text.size() != 16 || !std::all_of(text.begin(), text.end(), [](char c) { return c == '0' || c == '1'; })) return false;
+        }
+        return true;
+    }
+
+    std::vector<uint16_t> parseText(std::string_view buffer) {
+        std::vector<uint16_t> words;
+        int line = 0;
+        for (std::size_t position = 0; position < buffer.size(); ) {
+            std::size_t end = buffer.find('\n', position);
+            if (end == std::string_view::npos) end = buffer.size();
+            std::string_view text = buffer.substr(position, end - position);
+            position = end + 1;
+            ++line;
+            if (!text.empty() && text.back() == '\r') text.remove_suffix(1);
+            if (text.empty()) continue;
+            if (text.size() != 16) throw loadException("line " + std::to_string(line) + " isn't a 16bit word");
+
+            uint16_t word = 0;
+            for (char c : text) word = static_cast<uint16_t>((word << 1) | (c - '0'));
+            words.push_back(word);
+        }
+        return words;
+    }
+
+    std::vector<uint16_t> parseBinary(std::string_view buffer) {
+        if (buffer.size() % 2 != 0) throw loadException("binary program has an odd number of bytes");
+        std::vector<uint16_t> words(buffer.size() / 2);
+        for (std::size_t i = 0; i < words.size(); ++i)
+            words[i] = static_cast<uint16_t>(static_cast<unsigned char>(buffer[2 * i]) | (static_cast<unsigned char>(buffer[2 * i + 1]) << 8));
+        return words;
+    }
+}
+
+std::vector<uint16_t> loadHackFile(const std::string& path, HackFormat format) {
+    std::ifstream input(path, std::ios::in | std::ios::binary);
+    if (input.fail()) throw fileException(path);
+    std::string buffer((std::istreambuf_iterator<char>(input)), std::istreambuf_iterator<char>());
+
+    if (format == HackFormat::detect) format = isText(buffer) ? HackFormat::text : HackFormat::binary;
+    std::vector<uint16_t> words = (format == HackFormat::text) ? parseText(buffer) : parseBinary(buffer);
+    if (words.size() > ROM_SIZE) throw loadException("program has " + std::to_string(words.size()) + " words(ROM is 32K)");
+    return words;
+}
@@ -0,0 +1,26 @@
+/**
+    HackFile Module
+    Loads a program written by the 06 Assembler.
+
+    Format
+    - text(--format=text): one "0101..." line(16 characters) per word.
+    - binary(--format=bin): raw little-endian 16bit words.
+    The Assembler writes both formats to .hack without a header, so a binary image made
+    only of the bytes '0', '1' and line breaks can look like text. Give the format
+    (--format) when it is known. Otherwise it is detected: a file whose every line is
+    16 '0'/'1' characters is text, and others are binary.
+
+    Routines
+    - loadHackFile(path, format): return the words. A program larger than ROM is an error.
+*/
+
+#ifndef __HACK_FILE_H__
+#define __HACK_FILE_H__
+
+#include "Global.h"
+
+enum class HackFormat { detect = 0, text = 1, binary = 2 };
+
+std::vector<uint16_t> loadHackFile(const std::string& path, HackFormat format = HackFormat::detect);
+
+#endif
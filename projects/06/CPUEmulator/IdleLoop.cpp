@@ -0,0 +1,33 @@
+/**
+    Implementation of IdleLoop.h
+*/
+
+#include "IdleLoop.h"
+
+std::vector<IdleLoop> findIdleLoops(const std::vector<uint16_t>& words) {
+    std::vector<IdleLoop> loops;
+    for (std::size_t head = 0; head < words.size(); ++head) {
+        int32_t a = -1;         // known value of A, or -1
+        bool check_ram = false;
+        for (std::size_t address = head; address < words.size() && address - head < MAX_IDLE_LENGTH; ++address) {
+            uint16_t word = words[address];
+            if ((word & 0x8000) == 0) {
+                a = word;
+                continue;
+            }
+
+            if ((word & 0x1000) && a == KBD) break;
+            if (word & 0x0008) check_ram = true;
+            if (word & 0x0007) {
+                if (a == static_cast<int32_t>(head)) {
+                    loops.push_back({static_cast<uint16_t>(head), static_cast<uint16_t>(address - head + 1), check_ram, {}, false, false, 0, 0, 0, {}});
+                    break;
+                }
+                if ((word & 0x0007) == 0x0007) break;
+                check_ram = true;   // exit branch
+            }
+            if (word & 0x0020) a = -1;
+        }
+    }
+    return loops;
+}
@@ -0,0 +1,53 @@
+/**
+    IdleLoop Module
+    Loops which may spin at a fixed point, like "(END) @END 0;JMP" and Sys.halt.
+
+    Candidate(found at load time)
+    - Words from head to the first jump back to head(A is @head there).
+      Jumps between them are conditional exits(ex. if-goto of Sys.halt's while loop).
+      The loop is at most MAX_IDLE_LENGTH words long.
+    - No word reads M at @KBD. A read at a computed address is allowed, because
+      RAM(KBD included) only changes inside run, so it reads the same value again.
+    - check_ram: some word has M in dest, or the loop has an exit.
+
+    Fixed point(checked by CPU::run)
+    - An iteration is a visit of head followed by the next visit length instructions later.
+    - Without check_ram, the iteration went straight through the words, so an iteration
+      which leaves A and D unchanged is a fixed point.
+    - With check_ram, RAM must also be unchanged. It is saved(into the loop's own snapshot)
+      on an iteration which leaves A and D unchanged, and compared on the next one.
+      Another loop visited in between(nested loops) can't replace the snapshot. Then the whole state is unchanged,
+      whichever way the iteration went. If RAM differs, the loop isn't idle
+      (ex. Sys.wait counts down a local), and head is never checked again until load.
+    - A fixed point repeats until the cycle budget of run ends, so run skips whole iterations
+      and only executes the last partial one. PC, A, D and RAM are exact at the end.
+
+    Routines
+    - findIdleLoops(words): return every candidate.
+*/
+
+#ifndef __IDLE_LOOP_H__
+#define __IDLE_LOOP_H__
+
+#include "Global.h"
+#include "MicroOp.h"
+
+constexpr std::size_t MAX_IDLE_LENGTH = 64;
+
+struct IdleLoop {
+    uint16_t head;
+    uint16_t length;
+    bool check_ram;
+    MicroOp op;                 // original op at head
+    /* Last visit of head in the current run. */
+    bool visited;
+    bool saved;                 // RAM was saved on the last visit
+    int16_t a;
+    int16_t d;
+    uint64_t cycle;
+    std::vector<int16_t> ram;   // snapshot of the last visit(check_ram)
+};
+
+std::vector<IdleLoop> findIdleLoops(const std::vector<uint16_t>& words);
+
+#endif
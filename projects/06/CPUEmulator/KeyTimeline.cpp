@@ -0,0 +1,76 @@
+/**
+    Implementation of KeyTimeline.h
+*/
+
+#include "KeyTimeline.h"
+#include <sstream>
+
+namespace {
+    const std::pair<const char*, int16_t> KEY_NAMES[] = {
+        {"space", 32}, {"newline", 128}, {"backspace", 129}, {"left", 130}, {"up", 131}, {"right", 132},
+        {"down", 133}, {"home", 134}, {"end", 135}, {"pageup", 136}, {"pagedown", 137}, {"insert", 138},
+        {"delete", 139}, {"esc", 140}
+    };
+
+    bool parseKey(const std::string& text, int16_t& key) {
+        for (const auto& name : KEY_NAMES) {
+            if (text == name.first) {
+                key = name.second;
+                return true;
+            }
+        }
+        if (text.size() >= 2 && text.size() <= 3 && text[0] == 'f' && std::all_of(text.begin() + 1, text.end(), ::isdigit)) {
+            int number = std::stoi(text.substr(1));
+            if (number < 1 || number > 12) return false;
+            key = static_cast<int16_t>(140 + number);
+            return true;
+        }
+        /* A quoted character('5', '#') is the character itself, so a digit key isn't a key code. */
+        if (text.size() == 3 && text.front() == '\'' && text.back() == '\'' && text[1] > 32 && text[1] < 127) {
+            key = static_cast<int16_t>(text[1]);
+            return true;
+        }
+        if (std::all_of(text.begin(), text.end(), ::isdigit)) {
+            if (text.size() > 5 || std::stoi(text) > INT16_MAX) return false;
+            key = static_cast<int16_t>(std::stoi(text));
+            return true;
+        }
+        if (text.size() == 1 && text[0] > 32 && text[0] < 127) {
+            key = static_cast<int16_t>(text[0]);
+            return true;
+        }
+        return false;
+    }
+}
+
+std::vector<KeyEvent> loadKeyTimeline(const std::string& path) {
+    std::ifstream input(path);
+    if (input.fail()) throw fileException(path);
+
+    std::vector<KeyEvent> events;
+    int line_number = 0;
+    for (std::string line; std::getline(input, line); ) {
+        ++line_number;
+        std::istringstream fields(line);
+        std::string cycle;
+        std::string key;
+        std::string rest;
+        if (!(fields >> cycle) || cycle[0] == '#') continue;
+        /* '#' only starts a comment as a field of its own after the key, so "100 #" is the key '#'. */
+        if (!(fields >> key) || !std::all_of(cycle.begin(), cycle.end(), ::isdigit)
+            || ((fields >> rest) && rest[0] != '#'))
+            throw scriptException(path, line_number, "an event is \"cycle key\"");
+
+        KeyEvent event = {0, 0};
+        try {
+            event.cycle = std::stoull(cycle);
+        } catch (std::out_of_range&) {
+            throw scriptException(path, line_number, "cycle out of range(" + cycle + ")");
+        }
+        if (!parseKey(key, event.key)) throw scriptException(path, line_number, "unknown key(" + key + ")");
+        if (!events.empty() && event.cycle < events.back().cycle)
+            throw scriptException(path, line_number, "cycles must not decrease");
+        events.push_back(event);
+    }
+    return events;
+}
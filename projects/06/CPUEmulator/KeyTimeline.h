@@ -0,0 +1,39 @@
+/**
+    KeyTimeline Module
+    Scripted keyboard input(--keys). Each event sets RAM[KBD] at an exact cycle.
+
+    File(one event per line)
+    cycle key [# comment]
+    - cycle: CPU cycle count(CPU::cycles, a restored snapshot included) at which the key
+             is set, before that instruction is executed. Cycles must not decrease.
+    - key: Hack key code(0 ~ 32767, 0 is no key), a single printable character, a quoted
+           character('5' is the key 5, not the code 5), or a name:
+           space, newline, backspace, left, up, right, down, home, end, pageup, pagedown,
+           insert, delete, esc, f1 ~ f12
+    - A line starting with '#' is a comment, and so is a field starting with '#' after the key.
+      '#' as the key itself is the character, so "100 #" presses '#'.
+    The key stays in RAM[KBD] until the next event, so release a key with "cycle 0".
+
+    Example
+    1000000 left
+    3000000 0
+    3500000 q       # quit
+    4000000 '5'
+
+    Routines
+    - loadKeyTimeline(path): return the events.
+*/
+
+#ifndef __KEY_TIMELINE_H__
+#define __KEY_TIMELINE_H__
+
+#include "Global.h"
+
+struct KeyEvent {
+    uint64_t cycle;
+    int16_t key;
+};
+
+std::vector<KeyEvent> loadKeyTimeline(const std::string& path);
+
+#endif
@@ -0,0 +1,136 @@
+/**
+    MicroOp Module
+    Pre-decoded form of a ROM word. Each word is decoded once at load time,
+    so the CPU loop only switches on alu and never looks at instruction bits.
+
+    MicroOp
+    - alu: what the instruction computes. LOAD is an A-Command(A = value).
+           Each C-Command comp of the Hack spec has its own entry, and the
+           A and M forms(ex. D+A, D+M) are separate entries. An unlisted comp bit
+           pattern is GENERIC_A/GENERIC_M, and value keeps its 6 ALU control bits.
+           HALT is placed after the last word of the program.
+           Entries from PUSH_D are superinstructions made by Fusion.h.
+    - dest: A(4), D(2), M(1) like the d1 d2 d3 bits.
+    - jump: LT(4), EQ(2), GT(1) like the j1 j2 j3 bits.
+    - length: number of ROM words the op executes(1 unless fused).
+    - operand: second constant of a superinstruction.
+
+    Routines
+    - decode(word): return the micro-op of a ROM word.
+    - computeALU(control, x, y): the Hack ALU(zx, nx, zy, ny, f, no) for GENERIC.
+    - jumpClass(out): LT, EQ or GT bit of out, to be tested against jump.
+*/
+
+#ifndef __MICRO_OP_H__
+#define __MICRO_OP_H__
+
+#include "Global.h"
+
+enum class ALU : uint8_t {
+    LOAD,
+    ZERO, ONE, MINUS_ONE,
+    D, A, M,
+    NOT_D, NOT_A, NOT_M,
+    NEG_D, NEG_A, NEG_M,
+    D_PLUS_1, A_PLUS_1, M_PLUS_1,
+    D_MINUS_1, A_MINUS_1, M_MINUS_1,
+    D_PLUS_A, D_PLUS_M,
+    D_MINUS_A, D_MINUS_M,
+    A_MINUS_D, M_MINUS_D,
+    D_AND_A, D_AND_M,
+    D_OR_A, D_OR_M,
+    GENERIC_A, GENERIC_M,
+    /* Superinstructions(Fusion.h). X is value, Y is operand. */
+    PUSH_D, PUSH_D_PRE, POP_D, POP_A,
+    LOAD_D_M, LOAD_D_A, STORE_D, LOAD_A_M,
+    INC_M, DEC_M,
+    JUMP, JUMP_IF_D,
+    SEGMENT,
+    /* Head of an idle loop candidate(IdleLoop.h). value is its index. */
+    IDLE,
+    HALT
+};
+
+namespace Dest {
+    constexpr uint8_t A = 4;
+    constexpr uint8_t D = 2;
+    constexpr uint8_t M = 1;
+}
+
+namespace Jump {
+    constexpr uint8_t LT = 4;
+    constexpr uint8_t EQ = 2;
+    constexpr uint8_t GT = 1;
+}
+
+struct MicroOp {
+    ALU alu;
+    uint8_t dest;
+    uint8_t jump;
+    uint8_t length;
+    uint16_t value;
+    uint16_t operand;
+};
+
+constexpr MicroOp HALT_OP = {ALU::HALT, 0, 0, 1, 0, 0};
+
+/* ALU control bits(c1~c6) of each comp. The A form is listed, and the M form is next to it in ALU. */
+constexpr uint8_t COMP_CONTROL[][2] = {
+    {0b101010, static_cast<uint8_t>(ALU::ZERO)},
+    {0b111111, static_cast<uint8_t>(ALU::ONE)},
+    {0b111010, static_cast<uint8_t>(ALU::MINUS_ONE)},
+    {0b001100, static_cast<uint8_t>(ALU::D)},
+    {0b110000, static_cast<uint8_t>(ALU::A)},
+    {0b001101, static_cast<uint8_t>(ALU::NOT_D)},
+    {0b110001, static_cast<uint8_t>(ALU::NOT_A)},
+    {0b001111, static_cast<uint8_t>(ALU::NEG_D)},
+    {0b110011, static_cast<uint8_t>(ALU::NEG_A)},
+    {0b011111, static_cast<uint8_t>(ALU::D_PLUS_1)},
+    {0b110111, static_cast<uint8_t>(ALU::A_PLUS_1)},
+    {0b001110, static_cast<uint8_t>(ALU::D_MINUS_1)},
+    {0b110010, static_cast<uint8_t>(ALU::A_MINUS_1)},
+    {0b000010, static_cast<uint8_t>(ALU::D_PLUS_A)},
+    {0b010011, static_cast<uint8_t>(ALU::D_MINUS_A)},
+    {0b000111, static_cast<uint8_t>(ALU::A_MINUS_D)},
+    {0b000000, static_cast<uint8_t>(ALU::D_AND_A)},
+    {0b010101, static_cast<uint8_t>(ALU::D_OR_A)}
+};
+
+inline bool usesY(ALU alu) {
+    return alu == ALU::A || alu == ALU::NOT_A || alu == ALU::NEG_A || alu == ALU::A_PLUS_1 || alu == ALU::A_MINUS_1
+        || alu == ALU::D_PLUS_A || alu == ALU::D_MINUS_A || alu == ALU::A_MINUS_D || alu == ALU::D_AND_A || alu == ALU::D_OR_A;
+}
+
+inline MicroOp decode(uint16_t word) {
+    if ((word & 0x8000) == 0) return {ALU::LOAD, 0, 0, 1, word, 0};
+
+    uint8_t control = (word >> 6) & 0x3f;
+    bool m = (word & 0x1000) != 0;
+    MicroOp op = {m ? ALU::GENERIC_M : ALU::GENERIC_A, static_cast<uint8_t>((word >> 3) & 0x7), static_cast<uint8_t>(word & 0x7), 1, control, 0};
+    for (const auto& entry : COMP_CONTROL) {
+        if (entry[0] != control) continue;
+        ALU alu = static_cast<ALU>(entry[1]);
+        /* A comp without A(ex. D+1) ignores the a bit. */
+        if (m && usesY(alu)) alu = static_cast<ALU>(entry[1] + 1);
+        op.alu = alu;
+        op.value = 0;
+        break;
+    }
+    return op;
+}
+
+inline int16_t computeALU(uint16_t control, int16_t x, int16_t y) {
+    if (control & 0x20) x = 0;
+    if (control & 0x10) x = ~x;
+    if (control & 0x08) y = 0;
+    if (control & 0x04) y = ~y;
+    int16_t out = (control & 0x02) ? static_cast<int16_t>(x + y) : static_cast<int16_t>(x & y);
+    if (control & 0x01) out = ~out;
+    return out;
+}
+
+inline uint8_t jumpClass(int16_t out) {
+    return (out < 0) ? Jump::LT : ((out == 0) ? Jump::EQ : Jump::GT);
+}
+
+#endif
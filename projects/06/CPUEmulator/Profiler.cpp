@@ -0,0 +1,116 @@
+/**
+    Implementation of Profiler.h
+*/
+
+#include "Profiler.h"
+#include <iomanip>
+#include <numeric>
+
+namespace {
+    bool isReturnLabel(std::string_view name) {
+        return name.size() > 6 && name.compare(0, 6, "RETURN") == 0
+            && std::all_of(name.begin() + 6, name.end(), [](char c) { return c >= '0' && c <= '9'; });
+    }
+}
+
+/* =========== PRIVATE ============= */
+
+uint32_t Profiler::child(uint32_t parent, uint32_t function) {
+    uint64_t key = (static_cast<uint64_t>(parent) << 32) | function;
+    auto found = children_.find(key);
+    if (found != children_.end()) return found->second;
+
+    uint32_t node = static_cast<uint32_t>(nodes_.size());
+    nodes_.push_back({function, parent, 0});
+    children_.emplace(key, node);
+    return node;
+}
+
+std::string Profiler::stackOf(uint32_t node) const {
+    std::vector<uint32_t> path;
+    for (; node != 0; node = nodes_[node].parent) path.push_back(nodes_[node].function);
+    if (path.empty()) return functions_[0];
+
+    std::string stack;
+    for (auto function = path.rbegin(); function != path.rend(); ++function)
+        stack += (stack.empty() ? "" : ";") + functions_[*function];
+    return stack;
+}
+
+/* =========== PUBLIC ============= */
+
+Profiler::Profiler(const std::string& map_path, bool sampling)
+: sampling_(sampling), functions_(1, "[no function]"), function_of_(ROM_SIZE + 1, 0), events_(ROM_SIZE + 1, 0),
+  counts_(ROM_SIZE + 1, 0), nodes_(1, {0, 0, 0}), node_(0), previous_(ROM_SIZE) {
+    map_.load(map_path);
+
+    /* Function intervals are sorted, so each one covers up to the next. */
+    for (std::size_t i = 0; i < map_.functions.size(); ++i) {
+        functions_.push_back(map_.names[map_.functions[i].name]);
+        std::size_t begin = std::min<std::size_t>(map_.functions[i].begin, ROM_SIZE);
+        std::size_t end = (i + 1 < map_.functions.size()) ? std::min<std::size_t>(map_.functions[i + 1].begin, ROM_SIZE) : ROM_SIZE;
+        std::fill(function_of_.begin() + begin, function_of_.begin() + end, static_cast<uint32_t>(i + 1));
+    }
+    for (const SourceInterval& label : map_.labels) {
+        if (!isReturnLabel(map_.names[label.name]) || label.begin == 0 || label.begin >= ROM_SIZE) continue;
+        events_[label.begin] |= RETURN_POINT;
+        events_[label.begin - 1] |= CALL_SITE;
+    }
+}
+
+void Profiler::sample(uint16_t pc, const int16_t* ram) {
+    std::vector<uint32_t> stack(1, function_of_[pc]);
+    int lcl = ram[1];
+    while (stack.size() < MAX_DEPTH && lcl >= 5 && lcl < SCREEN) {
+        uint16_t ret = static_cast<uint16_t>(ram[lcl - 5]) & 0x7fff;
+        if (!(events_[ret] & RETURN_POINT)) break;
+        stack.push_back(function_of_[ret - 1]);     // the call site, RETURN<n> may begin the next function
+        lcl = ram[lcl - 4];
+    }
+
+    uint32_t node = 0;
+    for (auto function = stack.rbegin(); function != stack.rend(); ++function) {
+        if (*function != 0 || node != 0) node = child(node, *function);
+    }
+    ++counts_[pc];
+    ++nodes_[node].count;
+}
+
+void Profiler::write(const std::string& path) const {
+    std::ofstream output(path);
+    if (output.fail()) throw fileException(path);
+    for (uint32_t node = 0; node < nodes_.size(); ++node) {
+        if (nodes_[node].count > 0) output << stackOf(node) << " " << nodes_[node].count << "\n";
+    }
+}
+
+void Profiler::report(std::ostream& output, std::size_t top) const {
+    const char* unit = sampling_ ? "samples" : "instructions";
+    uint64_t total = std::accumulate(counts_.begin(), counts_.end(), uint64_t(0));
+    auto percent = [total](uint64_t count) { return total > 0 ? count * 100.0 / total : 0; };
+
+    std::vector<uint64_t> self(functions_.size(), 0);
+    for (std::size_t address = 0; address < counts_.size(); ++address) self[function_of_[address]] += counts_[address];
+    std::vector<uint32_t> order(functions_.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::sort(order.begin(), order.end(), [&self](uint32_t x, uint32_t y) { return self[x] > self[y]; });
+
+    output << "Self " << unit << " of " << total << " by function" << std::endl;
+    for (std::size_t i = 0; i < std::min(top, order.size()) && self[order[i]] > 0; ++i) {
+        output << std::fixed << std::setprecision(2) << std::setw(7) << percent(self[order[i]]) << "% "
+               << std::setw(12) << self[order[i]] << "  " << functions_[order[i]] << std::endl;
+    }
+
+    std::vector<uint32_t> addresses(counts_.size());
+    std::iota(addresses.begin(), addresses.end(), 0);
+    std::size_t shown = std::min(top, addresses.size());
+    std::partial_sort(addresses.begin(), addresses.begin() + shown, addresses.end(),
+                      [this](uint32_t x, uint32_t y) { return counts_[x] > counts_[y]; });
+    output << "Hottest addresses" << std::endl;
+    for (std::size_t i = 0; i < shown && counts_[addresses[i]] > 0; ++i) {
+        uint32_t address = addresses[i];
+        output << std::fixed << std::setprecision(2) << std::setw(7) << percent(counts_[address]) << "% "
+               << std::setw(12) << counts_[address] << "  " << address << "(line " << map_.line(address) << ", "
+               << functions_[function_of_[address]] << ")" << std::endl;
+    }
+}
@@ -0,0 +1,80 @@
+/**
+    Profiler Module(Class)
+    Instruction counts of a program folded into VM functions(--profile).
+    Function names come from the address/source map(.hmap) of the 06 Assembler(--map).
+
+    Modes
+    - exact: CPU::profile calls instruction(pc) before every instruction, so every ROM address
+             has its exact count. A call tree follows the VM calling convention of
+             CodeWriter(08 VMtranslator):
+             - call: "@Callee, 0;JMP" is followed by "(RETURN<n>)", so the word in front of
+                     a RETURN<n> label is a call site, and its target is pushed.
+             - return: reaching a RETURN<n> label pops the callee.
+    - sample: sample(pc, ram) is called every N instructions of CPU::run(fusion and idle loops kept).
+              The stack is unwound from the VM frames in RAM. The return address of a frame
+              is RAM[LCL - 5], and the caller's LCL is RAM[LCL - 4]. The caller is the function
+              of the call site(the word in front of the return address). Unwinding stops at a
+              return address which isn't a RETURN<n> label. A sample in the middle of
+              call or return code may show a frame twice or miss one.
+
+    Output
+    - write(path): folded stacks("Sys.init;Main.main;Math.multiply 1234" per line),
+                   the input of flamegraph.pl and speedscope.
+    - report(output, top): self count of the top functions and addresses(with .asm line).
+    Code in front of every function label(bootstrap) is "[no function]".
+
+    Routines
+    - instruction(pc), sample(pc, ram), write(path), report(output, top)
+*/
+
+#ifndef __PROFILER_H__
+#define __PROFILER_H__
+
+#include "Global.h"
+#include "../Assembler/SourceMap.h"
+#include <unordered_map>
+
+class Profiler {
+private:
+    static constexpr uint8_t CALL_SITE = 1;
+    static constexpr uint8_t RETURN_POINT = 2;
+    static constexpr std::size_t MAX_DEPTH = 1024;     // of unwinding
+
+    struct Node {
+        uint32_t function;
+        uint32_t parent;
+        uint64_t count;
+    };
+
+    SourceMap map_;
+    bool sampling_;
+    std::vector<std::string> functions_;        // [0] is "[no function]"
+    std::vector<uint32_t> function_of_;         // function of each address
+    std::vector<uint8_t> events_;
+    std::vector<uint64_t> counts_;              // instructions(or samples) of each address
+    std::vector<Node> nodes_;                   // call tree, [0] is the root
+    std::unordered_map<uint64_t, uint32_t> children_;
+    uint32_t node_;
+    uint32_t previous_;
+
+private:
+    uint32_t child(uint32_t parent, uint32_t function);
+    std::string stackOf(uint32_t node) const;
+
+public:
+    Profiler(const std::string& map_path, bool sampling);
+
+    void instruction(uint16_t pc) {
+        if (events_[previous_] & CALL_SITE) node_ = child(node_, function_of_[pc]);
+        else if (events_[pc] & RETURN_POINT) node_ = nodes_[node_].parent;
+        ++counts_[pc];
+        ++nodes_[node_].count;
+        previous_ = pc;
+    }
+    void sample(uint16_t pc, const int16_t* ram);
+
+    void write(const std::string& path) const;
+    void report(std::ostream& output, std::size_t top) const;
+};
+
+#endif
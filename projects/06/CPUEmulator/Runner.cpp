@@ -0,0 +1,144 @@
+/**
+    Implementation of Runner.h
+*/
+
+#include "Runner.h"
+#include <chrono>
+#include <memory>
+#include <sstream>
+#include "CPU.h"
+#include "BinaryTranslator.h"
+#include "Profiler.h"
+#include "Snapshot.h"
+#include "KeyTimeline.h"
+#include "TestScript.h"
+
+RunOption parseRunOption(const std::vector<std::string>& args) {
+    RunOption option;
+    for (const std::string& arg : args) {
+        if (arg.rfind("--cycles=", 0) == 0) {
+            option.cycles = std::stoull(arg.substr(9));
+        } else if (arg.rfind("--set=", 0) == 0) {
+            std::size_t equal = arg.find('=', 6);
+            if (equal == std::string::npos) throw std::invalid_argument("--set needs address=value");
+            option.sets.push_back({std::stoi(arg.substr(6, equal - 6)), std::stoi(arg.substr(equal + 1))});
+        } else if (arg.rfind("--print=", 0) == 0) {
+            std::stringstream list(arg.substr(8));
+            for (std::string address; std::getline(list, address, ','); ) option.prints.push_back(std::stoi(address));
+        } else if (arg == "--no-fusion") {
+            option.fusion = false;
+        } else if (arg == "--no-idle") {
+            option.idle = false;
+        } else if (arg.rfind("--profile=", 0) == 0) {
+            option.profile_path = arg.substr(10);
+        } else if (arg.rfind("--sample=", 0) == 0) {
+            option.sample = std::stoull(arg.substr(9));
+        } else if (arg.rfind("--map=", 0) == 0) {
+            option.map_path = arg.substr(6);
+        } else if (arg.rfind("--snapshot=", 0) == 0) {
+            option.snapshot_path = arg.substr(11);
+        } else if (arg.rfind("--save-snapshot=", 0) == 0) {
+            option.save_snapshot_path = arg.substr(16);
+        } else if (arg.rfind("--keys=", 0) == 0) {
+            option.keys_path = arg.substr(7);
+        } else if (arg == "--format=text") {
+            option.format = HackFormat::text;
+        } else if (arg == "--format=bin") {
+            option.format = HackFormat::binary;
+        } else if (arg.rfind("--translate=", 0) == 0) {
+            option.translate_path = arg.substr(12);
+        } else {
+            option.path = arg;
+        }
+    }
+    return option;
+}
+
+int runJob(const RunOption& option, std::ostream& output) {
+    if (option.path.size() > 4 && option.path.compare(option.path.size() - 4, 4, ".tst") == 0) {
+        TestScript script(option.path, output);
+        bool passed = script.run();
+        output << script.message() << std::endl;
+        return passed ? 0 : 1;
+    }
+
+    std::vector<uint16_t> words = loadHackFile(option.path, option.format);
+    if (!option.translate_path.empty()) {
+        BinaryTranslator translator;
+        translator.translate(words, option.translate_path);
+        return 0;
+    }
+
+    std::vector<KeyEvent> keys;
+    if (!option.keys_path.empty()) keys = loadKeyTimeline(option.keys_path);
+
+    std::unique_ptr<CPU> cpu = std::make_unique<CPU>();
+    cpu->load(words, option.fusion, option.idle);
+    if (!option.snapshot_path.empty()) {
+        auto restore_start = std::chrono::steady_clock::now();
+        loadSnapshot(option.snapshot_path, *cpu, romHash(words));
+        double restore_seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - restore_start).count();
+        output << "Restored snapshot at cycle " << cpu->cycles() << " in " << restore_seconds * 1000 << " ms" << std::endl;
+    }
+    for (const auto& set : option.sets) cpu->ram(static_cast<uint16_t>(set.first)) = static_cast<int16_t>(set.second);
+
+    std::unique_ptr<Profiler> profiler;
+    if (!option.profile_path.empty()) {
+        std::string map_path = option.map_path;
+        if (map_path.empty()) map_path = option.path.substr(0, option.path.rfind('.')) + ".hmap";
+        profiler = std::make_unique<Profiler>(map_path, option.sample > 0);
+    }
+
+    /* Run at most n instructions, and return the number executed. */
+    uint64_t since_sample = 0;
+    auto execute = [&](uint64_t n) -> uint64_t {
+        if (profiler == nullptr) return cpu->run(n);
+        if (option.sample == 0) return cpu->profile(n, *profiler);
+        uint64_t done = 0;
+        while (done < n) {
+            uint64_t chunk = std::min(option.sample - since_sample, n - done);
+            uint64_t count = cpu->run(chunk);
+            done += count;
+            since_sample += count;
+            if (count < chunk) break;
+            if (since_sample == option.sample) {
+                profiler->sample(cpu->pc(), cpu->ram());
+                since_sample = 0;
+            }
+        }
+        return done;
+    };
+
+    /* Runs stop at each key event, so the key is set at its exact cycle. */
+    auto start = std::chrono::steady_clock::now();
+    uint64_t executed = 0;
+    std::size_t next_key = 0;
+    while (executed < option.cycles) {
+        for (; next_key < keys.size() && keys[next_key].cycle <= cpu->cycles(); ++next_key)
+            cpu->ram(KBD) = keys[next_key].key;
+        uint64_t limit = option.cycles - executed;
+        if (next_key < keys.size()) limit = std::min(limit, keys[next_key].cycle - cpu->cycles());
+        uint64_t done = execute(limit);
+        executed += done;
+        if (done < limit) break;
+    }
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    output << "Executed " << executed << " instructions in " << seconds * 1000 << " ms("
+           << (seconds > 0 ? executed / seconds / 1e6 : 0) << " M instructions/sec)"
+           << (cpu->halted() ? ", halted at PC " + std::to_string(cpu->pc()) : "") << std::endl;
+    if (cpu->idlePC() >= 0)
+        output << "Idle loop at PC " << cpu->idlePC() << ": fast-forwarded " << cpu->idleCycles() << " instructions" << std::endl;
+    if (option.fusion && (profiler == nullptr || option.sample > 0))
+        output << "Fused: " << cpu->fusedCycles() << " instructions("
+               << (executed > 0 ? cpu->fusedCycles() * 100.0 / executed : 0) << "%)" << std::endl;
+    for (int address : option.prints)
+        output << "RAM[" << address << "] = " << cpu->ram(static_cast<uint16_t>(address)) << std::endl;
+    if (!keys.empty()) output << "Keyboard: " << next_key << " of " << keys.size() << " events injected" << std::endl;
+    if (!option.save_snapshot_path.empty()) saveSnapshot(option.save_snapshot_path, *cpu, romHash(words));
+    if (profiler != nullptr) {
+        profiler->write(option.profile_path);
+        profiler->report(output, 10);
+    }
+    return 0;
+}
@@ -0,0 +1,40 @@
+/**
+    Runner Module
+    One emulator job: a program(or test script) and its options(see main.cpp).
+    main runs one job, and Batch runs many of them on threads.
+
+    Routines
+    - parseRunOption(args): options and filePath of one job. An unknown --option is filePath.
+    - runJob(option, output): run the job, write its report to output, and return
+                              the exit status(1 if a test script comparison fails).
+                              Errors are thrown. A job only touches its own CPU and files,
+                              so jobs may run on different threads.
+*/
+
+#ifndef __RUNNER_H__
+#define __RUNNER_H__
+
+#include "Global.h"
+#include "HackFile.h"
+
+struct RunOption {
+    std::string path = "";
+    HackFormat format = HackFormat::detect;
+    uint64_t cycles = 100000000;
+    std::vector<std::pair<int, int>> sets;
+    std::vector<int> prints;
+    std::string translate_path = "";
+    bool fusion = true;
+    bool idle = true;
+    std::string profile_path = "";
+    uint64_t sample = 0;
+    std::string map_path = "";
+    std::string snapshot_path = "";
+    std::string save_snapshot_path = "";
+    std::string keys_path = "";
+};
+
+RunOption parseRunOption(const std::vector<std::string>& args);
+int runJob(const RunOption& option, std::ostream& output);
+
+#endif
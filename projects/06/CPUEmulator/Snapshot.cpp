@@ -0,0 +1,93 @@
+/**
+    Implementation of Snapshot.h
+*/
+
+#include "Snapshot.h"
+#include <cstring>
+
+#if defined(_WIN32)
+#include <sstream>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace {
+    const char MAGIC[8] = {'H', 'A', 'C', 'K', 'S', 'N', 'P', '1'};
+    constexpr std::size_t SNAPSHOT_SIZE = sizeof(SnapshotHeader) + RAM_SIZE * sizeof(int16_t);
+
+    void restore(const std::string& path, const char* data, std::size_t size, CPU& cpu, uint64_t hash) {
+        if (size != SNAPSHOT_SIZE) throw loadException("broken snapshot(" + path + ")");
+        SnapshotHeader header;
+        std::memcpy(&header, data, sizeof(header));
+        if (std::memcmp(header.magic, MAGIC, sizeof(MAGIC)) != 0) throw loadException("broken snapshot(" + path + ")");
+        if (header.rom_hash != hash || header.program_size != cpu.programSize())
+            throw loadException("snapshot(" + path + ") was saved from another program");
+
+        std::memcpy(cpu.ram(), data + sizeof(header), RAM_SIZE * sizeof(int16_t));
+        cpu.setPC(header.pc);
+        cpu.setA(header.a);
+        cpu.setD(header.d);
+        cpu.setCycles(header.cycles);
+    }
+}
+
+uint64_t romHash(const std::vector<uint16_t>& words) {
+    uint64_t hash = 14695981039346656037ull;    // FNV-1a
+    for (uint16_t word : words) {
+        for (int shift = 0; shift < 16; shift += 8) {
+            hash ^= (word >> shift) & 0xff;
+            hash *= 1099511628211ull;
+        }
+    }
+    return hash;
+}
+
+void saveSnapshot(const std::string& path, const CPU& cpu, uint64_t hash) {
+    SnapshotHeader header = {};
+    std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+    header.rom_hash = hash;
+    header.cycles = cpu.cycles();
+    header.program_size = static_cast<uint32_t>(cpu.programSize());
+    header.pc = cpu.pc();
+    header.a = cpu.a();
+    header.d = cpu.d();
+
+    std::ofstream output(path, std::ios::out | std::ios::binary);
+    if (output.fail()) throw fileException(path);
+    output.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    output.write(reinterpret_cast<const char*>(cpu.ram()), RAM_SIZE * sizeof(int16_t));
+    if (output.fail()) throw fileException(path);
+}
+
+void loadSnapshot(const std::string& path, CPU& cpu, uint64_t hash) {
+#if defined(_WIN32)
+    std::ifstream input(path, std::ios::in | std::ios::binary);
+    if (input.fail()) throw fileException(path);
+    std::ostringstream buffer;
+    buffer << input.rdbuf();
+    std::string data = buffer.str();
+    restore(path, data.data(), data.size(), cpu, hash);
+#else
+    int fd = open(path.c_str(), O_RDONLY);
+    if (fd < 0) throw fileException(path);
+    struct stat status;
+    if (fstat(fd, &status) < 0) {
+        close(fd);
+        throw fileException(path);
+    }
+    std::size_t size = static_cast<std::size_t>(status.st_size);
+    void* mapped = (size > 0) ? mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0) : MAP_FAILED;
+    close(fd);
+    if (mapped == MAP_FAILED) throw loadException("broken snapshot(" + path + ")");
+    try {
+        restore(path, static_cast<const char*>(mapped), size, cpu, hash);
+    } catch (std::exception& e) {
+        munmap(mapped, size);
+        throw;
+    }
+    munmap(mapped, size);
+#endif
+}
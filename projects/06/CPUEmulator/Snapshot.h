@@ -0,0 +1,40 @@
+/**
+    Snapshot Module
+    Whole machine state in one file, to start runs from a checkpoint(ex. after Sys.init).
+
+    File(host byte order, 64 byte header followed by RAM)
+    - magic "HACKSNP1"
+    - ROM hash(u64): FNV-1a of the program words. A snapshot only restores onto the same program.
+    - cycles(u64), program size(u32), PC(u16), A(i16), D(i16), reserved
+    - RAM: 32K int16_t words, the same layout as CPU::ram(), so restore is one mmap and one copy.
+
+    Routines
+    - romHash(words)
+    - saveSnapshot(path, cpu, hash)
+    - loadSnapshot(path, cpu, hash): a broken file or another program is a loadException.
+*/
+
+#ifndef __SNAPSHOT_H__
+#define __SNAPSHOT_H__
+
+#include "Global.h"
+#include "CPU.h"
+
+struct SnapshotHeader {
+    char magic[8];
+    uint64_t rom_hash;
+    uint64_t cycles;
+    uint32_t program_size;
+    uint16_t pc;
+    int16_t a;
+    int16_t d;
+    uint16_t reserved[15];
+};
+
+static_assert(sizeof(SnapshotHeader) == 64, "snapshot header must be 64 bytes");
+
+uint64_t romHash(const std::vector<uint16_t>& words);
+void saveSnapshot(const std::string& path, const CPU& cpu, uint64_t hash);
+void loadSnapshot(const std::string& path, CPU& cpu, uint64_t hash);
+
+#endif
@@ -0,0 +1,343 @@
+/**
+    Implementation of TestScript.h
+*/
+
+#include "TestScript.h"
+#include "HackFile.h"
+#include "AsmFile.h"
+#include <sstream>
+
+namespace {
+    struct Token {
+        std::string text;
+        int line;
+    };
+
+    /* Words, quoted strings and the punctuations ',', ';', '{', '}'. Comments are skipped. */
+    std::vector<Token> tokenize(const std::string& script) {
+        std::vector<Token> tokens;
+        int line = 1;
+        for (std::size_t position = 0; position < script.size(); ) {
+            char c = script[position];
+            if (c == '\n') {
+                ++line;
+                ++position;
+            } else if (std::isspace(static_cast<unsigned char>(c))) {
+                ++position;
+            } else if (script.compare(position, 2, "//") == 0) {
+                position = script.find('\n', position);
+                if (position == std::string::npos) position = script.size();
+            } else if (script.compare(position, 2, "/*") == 0) {
+                std::size_t end = script.find("*/", position + 2);
+                end = (end == std::string::npos) ? script.size() : end + 2;
+                line += static_cast<int>(std::count(script.begin() + position, script.begin() + end, '\n'));
+                position = end;
+            } else if (c == ',' || c == ';' || c == '{' || c == '}') {
+                tokens.push_back({std::string(1, c), line});
+                ++position;
+            } else if (c == '"') {
+                std::size_t end = script.find('"', position + 1);
+                if (end == std::string::npos) end = script.size();
+                tokens.push_back({script.substr(position + 1, end - position - 1), line});
+                position = end + 1;
+            } else {
+                std::size_t end = position;
+                while (end < script.size() && !std::isspace(static_cast<unsigned char>(script[end]))
+                       && std::string_view(",;{}").find(script[end]) == std::string_view::npos) ++end;
+                tokens.push_back({script.substr(position, end - position), line});
+                position = end;
+            }
+        }
+        return tokens;
+    }
+
+    /* Only repeat blocks are supported(while needs the simulators' expressions). */
+    int64_t repeatCount(const std::string& path, const ScriptCommand& command) {
+        if (command.words.empty() || command.words[0] != "repeat")
+            throw scriptException(path, command.line, "unsupported block(" + (command.words.empty() ? "{" : command.words[0]) + ")");
+        if (command.words.size() < 2) return -1;
+        try {
+            std::size_t end = 0;
+            int64_t count = std::stoll(command.words[1], &end);
+            if (end == command.words[1].size() && count >= 0 && command.words.size() == 2) return count;
+        } catch (std::exception&) { }
+        throw scriptException(path, command.line, "broken repeat count(" + command.words[1] + ")");
+    }
+
+    std::vector<ScriptCommand> parseBlock(const std::string& path, const std::vector<Token>& tokens, std::size_t& position, bool nested) {
+        std::vector<ScriptCommand> commands;
+        ScriptCommand current = {{}, 0, false, 0, {}};
+        for (; position < tokens.size(); ++position) {
+            const Token& token = tokens[position];
+            if (token.text == "," || token.text == ";") {
+                if (!current.words.empty()) commands.push_back(current);
+                current = {{}, 0, false, 0, {}};
+            } else if (token.text == "{") {
+                if (current.words.empty()) current.line = token.line;
+                current.block = true;
+                current.repeat = repeatCount(path, current);
+                current.body = parseBlock(path, tokens, ++position, true);
+                commands.push_back(current);
+                current = {{}, 0, false, 0, {}};
+            } else if (token.text == "}") {
+                if (!current.words.empty()) commands.push_back(current);
+                if (nested) return commands;
+                current = {{}, 0, false, 0, {}};
+            } else {
+                if (current.words.empty()) current.line = token.line;
+                current.words.push_back(token.text);
+            }
+        }
+        if (!current.words.empty()) commands.push_back(current);
+        return commands;
+    }
+
+    bool endsWith(const std::string& text, std::string_view suffix) {
+        return text.size() >= suffix.size() && text.compare(text.size() - suffix.size(), suffix.size(), suffix) == 0;
+    }
+
+    bool isARegister(const std::string& name) {
+        return name == "A" || name == "ARegister" || name == "ARegister[]" || name == "ARegister[0]";
+    }
+
+    bool isDRegister(const std::string& name) {
+        return name == "D" || name == "DRegister" || name == "DRegister[]" || name == "DRegister[0]";
+    }
+
+    bool isPC(const std::string& name) {
+        return name == "PC" || name == "PC[]";
+    }
+}
+
+/* =========== PRIVATE ============= */
+
+void TestScript::parse(const std::string& script) {
+    std::vector<Token> tokens = tokenize(script);
+    std::size_t position = 0;
+    commands_ = parseBlock(path_, tokens, position, false);
+}
+
+void TestScript::execute(const std::vector<ScriptCommand>& commands) {
+    for (const ScriptCommand& command : commands) {
+        if (failed_) return;
+        execute(command);
+    }
+}
+
+void TestScript::execute(const ScriptCommand& command) {
+    const std::vector<std::string>& words = command.words;
+    if (command.block) {
+        if (command.repeat < 0) throw scriptException(path_, command.line, "repeat without a count never ends");
+        int64_t ticks = ticksOf(command.body);
+        if (ticks >= 0) {
+            step(static_cast<uint64_t>(command.repeat * ticks));
+            return;
+        }
+        for (int64_t i = 0; i < command.repeat && !failed_; ++i) execute(command.body);
+        return;
+    }
+
+    const std::string& name = words[0];
+    if (name == "load") {
+        load(command, words.size() > 1 ? words[1] : "");
+    } else if (name == "ROM32K" && words.size() > 2 && words[1] == "load") {
+        load(command, words[2]);
+    } else if (name == "output-file") {
+        if (words.size() < 2) throw scriptException(path_, command.line, "output-file needs a file");
+        output_.open(directory_ + words[1]);
+        if (output_.fail()) throw fileException(directory_ + words[1]);
+    } else if (name == "compare-to") {
+        if (words.size() < 2) throw scriptException(path_, command.line, "compare-to needs a file");
+        compare_.open(directory_ + words[1]);
+        if (compare_.fail()) throw fileException(directory_ + words[1]);
+        comparing_ = true;
+    } else if (name == "output-list") {
+        columns_.clear();
+        std::string header = "|";
+        for (std::size_t i = 1; i < words.size(); ++i) {
+            std::size_t percent = words[i].find('%');
+            if (percent == std::string::npos || percent + 2 >= words[i].size())
+                throw scriptException(path_, command.line, "output-list item needs a format(" + words[i] + ")");
+            OutputColumn column = {words[i].substr(0, percent), words[i][percent + 1], 0, 0, 0};
+            char dot;
+            std::istringstream sizes(words[i].substr(percent + 2));
+            if (!(sizes >> column.left >> dot >> column.width >> dot >> column.right))
+                throw scriptException(path_, command.line, "broken format(" + words[i] + ")");
+            columns_.push_back(column);
+
+            std::size_t total = static_cast<std::size_t>(column.left + column.width + column.right);
+            std::string title = column.name.substr(0, total);
+            std::size_t left = (total - title.size()) / 2;
+            header += std::string(left, ' ') + title + std::string(total - title.size() - left, ' ') + "|";
+        }
+        writeLine(header);
+    } else if (name == "set") {
+        set(command);
+    } else if (name == "ticktock") {
+        step(1);
+    } else if (name == "tick") {
+        tick_ = true;
+    } else if (name == "tock") {
+        step(1);
+    } else if (name == "output") {
+        std::string line = "|";
+        for (const OutputColumn& column : columns_) line += format(command, column) + "|";
+        writeLine(line);
+    } else if (name == "echo") {
+        for (std::size_t i = 1; i < words.size(); ++i) echo_ << (i > 1 ? " " : "") << words[i];
+        echo_ << std::endl;
+    } else if (name != "clear-echo" && name != "breakpoint" && name != "clear-breakpoints") {
+        throw scriptException(path_, command.line, "unsupported command(" + name + ")");
+    }
+}
+
+/* Instructions per iteration if body only ticks, or -1. */
+int64_t TestScript::ticksOf(const std::vector<ScriptCommand>& body) const {
+    int64_t ticktocks = 0;
+    int64_t ticks = 0;
+    int64_t tocks = 0;
+    for (const ScriptCommand& command : body) {
+        if (command.block || command.words.size() != 1) return -1;
+        if (command.words[0] == "ticktock") ++ticktocks;
+        else if (command.words[0] == "tick") ++ticks;
+        else if (command.words[0] == "tock") ++tocks;
+        else return -1;
+    }
+    return (ticks == tocks) ? ticktocks + tocks : -1;
+}
+
+void TestScript::step(uint64_t cycles) {
+    if (reset_) {
+        for (uint64_t i = 0; i < cycles; ++i) {
+            cpu_.run(1);
+            cpu_.setPC(0);
+        }
+    } else {
+        cpu_.run(cycles);
+    }
+    time_ += cycles;
+    tick_ = false;
+}
+
+void TestScript::load(const ScriptCommand& command, const std::string& name) {
+    if (endsWith(name, ".hdl")) return;     // Computer chip, the program comes with ROM32K load
+
+    std::string path = directory_ + name;
+    std::vector<uint16_t> words;
+    if (endsWith(name, ".asm")) {
+        try {
+            words = assembleFile(path);
+        } catch (std::exception& e) {
+            throw scriptException(path_, command.line, e.what());
+        }
+    } else if (endsWith(name, ".hack")) {
+        words = loadHackFile(path);
+    } else {
+        throw scriptException(path_, command.line, "only .asm and .hack programs can be loaded(" + name + ")");
+    }
+    if (words.size() > ROM_SIZE) throw scriptException(path_, command.line, name + " is larger than ROM");
+    words.resize(ROM_SIZE, 0);
+    cpu_.load(words);
+}
+
+void TestScript::set(const ScriptCommand& command) {
+    const std::vector<std::string>& words = command.words;
+    if (words.size() != 3) throw scriptException(path_, command.line, "set needs a name and a value");
+
+    std::string text = words[2];
+    int base = 10;
+    if (text.size() > 2 && text[0] == '%') {
+        base = (text[1] == 'X') ? 16 : ((text[1] == 'B') ? 2 : 10);
+        text = text.substr(2);
+    }
+    int16_t value;
+    try {
+        value = static_cast<int16_t>(std::stol(text, nullptr, base));
+    } catch (std::exception& e) {
+        throw scriptException(path_, command.line, "broken value(" + words[2] + ")");
+    }
+
+    const std::string& name = words[1];
+    if (name == "reset") reset_ = (value != 0);
+    else if (isPC(name)) cpu_.setPC(static_cast<uint16_t>(value));
+    else if (isARegister(name)) cpu_.setA(value);
+    else if (isDRegister(name)) cpu_.setD(value);
+    else memory(command, name) = value;
+}
+
+int16_t& TestScript::memory(const ScriptCommand& command, const std::string& name) {
+    std::size_t open = name.find('[');
+    std::string chip = name.substr(0, open);
+    if (open == std::string::npos || name.back() != ']' || (chip != "RAM" && chip != "RAM16K"))
+        throw scriptException(path_, command.line, "unknown name(" + name + ")");
+    try {
+        return cpu_.ram(static_cast<uint16_t>(std::stoi(name.substr(open + 1))));
+    } catch (std::exception& e) {
+        throw scriptException(path_, command.line, "broken address(" + name + ")");
+    }
+}
+
+int16_t TestScript::read(const ScriptCommand& command, const std::string& name) {
+    if (name == "reset") return reset_ ? 1 : 0;
+    if (isPC(name)) return static_cast<int16_t>(cpu_.pc());
+    if (isARegister(name)) return cpu_.a();
+    if (isDRegister(name)) return cpu_.d();
+    return memory(command, name);
+}
+
+std::string TestScript::format(const ScriptCommand& command, const OutputColumn& column) {
+    std::string text;
+    if (column.name == "time") {
+        text = std::to_string(time_) + (tick_ ? "+" : "");
+    } else {
+        int16_t value = read(command, column.name);
+        if (column.format == 'X' || column.format == 'B') {
+            int bits = (column.format == 'X') ? 4 : 1;
+            for (int i = column.width - 1; i >= 0; --i)
+                text += "0123456789ABCDEF"[(static_cast<uint16_t>(value) >> (i * bits)) & ((1 << bits) - 1)];
+        } else {
+            text = std::to_string(value);
+        }
+    }
+
+    std::size_t width = static_cast<std::size_t>(column.width);
+    std::string padding = (text.size() < width) ? std::string(width - text.size(), ' ') : "";
+    text = (column.format == 'S') ? text + padding : padding + text;
+    return std::string(column.left, ' ') + text + std::string(column.right, ' ');
+}
+
+void TestScript::writeLine(const std::string& line) {
+    ++output_line_;
+    if (output_.is_open()) output_ << line << std::endl;
+    if (!comparing_) return;
+
+    std::string expected;
+    bool same = static_cast<bool>(std::getline(compare_, expected));
+    if (!expected.empty() && expected.back() == '\r') expected.pop_back();
+    same = same && expected.size() == line.size();
+    for (std::size_t i = 0; same && i < line.size(); ++i) same = (expected[i] == '*' || expected[i] == line[i]);
+    if (!same) {
+        failed_ = true;
+        message_ = "Comparison failure at line " + std::to_string(output_line_);
+    }
+}
+
+/* =========== PUBLIC ============= */
+
+TestScript::TestScript(const std::string& path, std::ostream& echo)
+: path_(path), echo_(echo), comparing_(false), output_line_(0), time_(0), tick_(false), reset_(false), failed_(false) {
+    std::size_t slash = path.find_last_of("/\\");
+    directory_ = (slash == std::string::npos) ? "" : path.substr(0, slash + 1);
+
+    std::ifstream input(path);
+    if (input.fail()) throw fileException(path);
+    std::string script((std::istreambuf_iterator<char>(input)), std::istreambuf_iterator<char>());
+    parse(script);
+}
+
+bool TestScript::run() {
+    execute(commands_);
+    if (failed_) return false;
+    message_ = comparing_ ? "End of script - Comparison ended successfully" : "End of script";
+    return true;
+}
@@ -0,0 +1,93 @@
+/**
+    TestScript Module(Class)
+    Runs the CPU emulator subset of .tst test scripts natively, and compares
+    the output with the .cmp file, as the CPU emulator and hardware simulator do.
+
+    Commands(separated by ',' or ';')
+    - load Prog.asm | Prog.hack: load a program. RAM is kept. A .asm is assembled in memory
+      (AsmFile.h), so a stale Prog.hack next to it doesn't matter.
+    - load Computer.hdl, ROM32K load Prog.hack: the Computer chip scripts of project 05.
+    - output-file, compare-to: file names are relative to the script.
+    - output-list name%Fl.w.r ...: F is D, X, B or S. The header line is written at once.
+    - set RAM[n] | RAM16K[n] | PC | A | D | reset value: value is decimal, or %D, %X, %B prefixed.
+    - repeat N { ... }, ticktock, tick, tock, output, echo(to the echo stream of the constructor)
+      Another block(ex. while out <> 75 { ... }) is rejected when the script is parsed.
+    A repeat whose body only ticks runs in one CPU::run, so fusion and idle loop
+    fast-forward(CPU.h) work for it.
+
+    Output names
+    - RAM[n], RAM16K[n], PC, PC[], A, ARegister[], ARegister[0], D, DRegister[], DRegister[0],
+      time("n" or "n+" after a tick), reset
+
+    Semantics
+    - ROM is padded with zero words(@0) up to 32K, same as the simulators,
+      so a program without an end loop doesn't halt.
+    - ticktock(or tick, tock) executes one instruction. With reset 1, PC becomes 0 after it.
+    - A mismatch with the .cmp line(a '*' in .cmp matches any character) stops the script.
+
+    Routines
+    - run: run the script, and return true if every output line matched(or there is no .cmp).
+    - message: "End of script - Comparison ended successfully", or the failure.
+*/
+
+#ifndef __TEST_SCRIPT_H__
+#define __TEST_SCRIPT_H__
+
+#include "Global.h"
+#include "CPU.h"
+
+struct ScriptCommand {
+    std::vector<std::string> words;
+    int line;
+    bool block;                 // repeat
+    int64_t repeat;             // -1 if no count
+    std::vector<ScriptCommand> body;
+};
+
+struct OutputColumn {
+    std::string name;
+    char format;
+    int left;
+    int width;
+    int right;
+};
+
+class TestScript {
+private:
+    std::string path_;
+    std::string directory_;
+    std::ostream& echo_;
+    std::vector<ScriptCommand> commands_;
+    CPU cpu_;
+    std::ofstream output_;
+    std::ifstream compare_;
+    bool comparing_;
+    int output_line_;
+    std::vector<OutputColumn> columns_;
+    uint64_t time_;
+    bool tick_;
+    bool reset_;
+    bool failed_;
+    std::string message_;
+
+private:
+    void parse(const std::string& script);
+    void execute(const std::vector<ScriptCommand>& commands);
+    void execute(const ScriptCommand& command);
+    int64_t ticksOf(const std::vector<ScriptCommand>& body) const;
+    void step(uint64_t cycles);
+    void load(const ScriptCommand& command, const std::string& name);
+    void set(const ScriptCommand& command);
+    int16_t& memory(const ScriptCommand& command, const std::string& name);
+    int16_t read(const ScriptCommand& command, const std::string& name);
+    std::string format(const ScriptCommand& command, const OutputColumn& column);
+    void writeLine(const std::string& line);
+
+public:
+    TestScript(const std::string& path, std::ostream& echo = std::cout);
+
+    bool run();
+    const std::string& message() const { return message_; }
+};
+
+#endif
@@ -0,0 +1,86 @@
+/**
+    Main CPU emulator program
+    Runs a .hack program(text or binary output of the 06 Assembler) natively.
+
+    Modules
+    - Runner: Parses the options of one job, and runs it.
+    - Batch: Runs the jobs of a job file on threads, and reports them together(--batch).
+    - HackFile: Loads .hack words.
+    - MicroOp: Decodes each ROM word once into a micro-op.
+    - Fusion: Fuses idioms of translated VM code into superinstructions.
+    - IdleLoop: Finds loops which may spin at a fixed point.
+    - CPU: Runs micro-ops in one dispatch loop over a flat 32K RAM.
+    - BinaryTranslator: Translates the program to C++ source(--translate).
+    - Profiler: Counts instructions by address and VM function(--profile).
+    - KeyTimeline: Loads scripted keyboard events(--keys).
+    - Snapshot: Saves and restores the whole machine state(--snapshot, --save-snapshot).
+    - TestScript: Runs a .tst test script, and compares its output with the .cmp file.
+    - AsmFile: Assembles a .asm program in memory(06 Assembler) for TestScript.
+
+    Options
+    - --cycles=N: execute at most N instructions(default 100000000).
+                  The run ends earlier if PC leaves the program.
+                  A loop spinning at a fixed point(ex. "(END) @END 0;JMP", Sys.halt)
+                  is fast-forwarded to the end of N, and reported.
+    - --set=address=value: set RAM[address] before running. It can be repeated.
+    - --print=address,address,...: print RAM[address] after running.
+    - --no-fusion: run every word as its own micro-op(for comparison).
+    - --no-idle: execute idle loops instead of fast-forwarding them(for benchmarks).
+    - --profile=output.folded: count every instruction, and write folded call stacks
+                               of VM functions(flame graph input). The top functions and
+                               addresses are printed. It needs the .hmap of Assembler --map.
+    - --sample=N: with --profile, sample the PC and the VM stack every N instructions
+                  instead of counting every instruction(fusion and idle loops are kept).
+    - --map=Prog.hmap: map for --profile(default: filePath with .hmap extension).
+    - --keys=timeline.txt: set RAM[KBD] at the cycles of a timeline(KeyTimeline.h), so an
+                           interactive program runs headless and the same every time.
+                           A program waiting for a key is fast-forwarded to the next event.
+    - --snapshot=file: start from a snapshot saved from the same program(before --set).
+    - --save-snapshot=file: save the machine state after running(ex. --cycles up to the end of Sys.init).
+    - --format=text|bin: format of filePath(default: detected, see HackFile.h).
+    - --translate=output.cpp: write the program as C++ source instead of running it.
+      The source is compiled by the host compiler, and takes the options above.
+    - --batch=jobs.txt: run every line of jobs.txt(options and filePath, Batch.h) as a job
+                        at the same time, and print one report. The exit status is 1
+                        if any job fails.
+    - --threads=N: threads of --batch(default: hardware threads).
+
+    A filePath ending with .tst is run as a test script(TestScript.h), and the other options are ignored.
+    The exit status is 1 if the comparison fails.
+
+    How to use
+    prompt> g++ -std=c++17 -O2 -pthread *.cpp ../Assembler/Assembler.cpp ../Assembler/Parser.cpp ../Assembler/RegionCache.cpp
+                ../Assembler/ObjectFile.cpp ../Assembler/Optimizer.cpp ../Assembler/SourceMap.cpp -o CPUEmulator
+    prompt> CPUEmulator [--format=text|bin] [--cycles=N] [--no-fusion] [--no-idle] [--set=address=value]... [--print=address,...] filePath
+    prompt> CPUEmulator --profile=Prog.folded [--sample=N] [--map=Prog.hmap] [--cycles=N] filePath
+    prompt> CPUEmulator --keys=Pong.keys --cycles=N filePath
+    prompt> CPUEmulator --cycles=N --save-snapshot=Prog.snap filePath && CPUEmulator --snapshot=Prog.snap filePath
+    prompt> CPUEmulator Prog.tst
+    prompt> CPUEmulator test/IdleLoops.tst      (nested idle loop candidates, IdleLoop.h)
+    prompt> CPUEmulator --batch=jobs.txt [--threads=N]
+    prompt> CPUEmulator --translate=Prog.cpp filePath && g++ -O2 Prog.cpp -o Prog && Prog [--cycles=N] ...
+*/
+
+#include "Global.h"
+#include "Runner.h"
+#include "Batch.h"
+
+int main(int argc, char* argv[]) {
+    try {
+        std::string batch_path = "";
+        std::size_t threads = 0;
+        std::vector<std::string> args;
+        for (int i = 1; i < argc; ++i) {
+            std::string arg = argv[i];
+            if (arg.rfind("--batch=", 0) == 0) batch_path = arg.substr(8);
+            else if (arg.rfind("--threads=", 0) == 0) threads = std::stoul(arg.substr(10));
+            else args.push_back(arg);
+        }
+
+        if (!batch_path.empty()) return runBatch(batch_path, threads, std::cout);
+        return runJob(parseRunOption(args), std::cout);
+    } catch (std::exception& e) {
+        std::cout << e.what() << std::endl;
+        return 1;
+    }
+}
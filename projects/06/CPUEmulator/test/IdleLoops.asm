@@ -0,0 +1,56 @@
+// File name: projects/06/CPUEmulator/test/IdleLoops.asm
+
+// Two idle loop candidates which are visited in turn(OUTER contains INNER).
+// Each OUTER iteration increments x, and runs INNER until c is 0.
+// INNER saves its RAM snapshot in the middle of an OUTER iteration, and at the
+// next OUTER visit RAM equals that snapshot(not OUTER's own), so OUTER must not
+// be taken as idle. After 100 iterations the program ends in the END loop,
+// which is fast-forwarded.
+// Every OUTER iteration executes as many words as OUTER has(SKIP pads it),
+// so it is checked as a candidate at every visit.
+
+(OUTER)
+    @x
+    M=M+1
+    @3
+    D=A
+    @c
+    M=D
+(INNER)
+    @c
+    MD=M-1
+    @DONE
+    D;JEQ
+    D=0
+    @INNER
+    D;JEQ
+(DONE)
+    @c
+    M=1
+    D=0
+    @SKIP
+    D;JEQ
+    D=0
+    D=0
+    D=0
+    D=0
+    D=0
+    D=0
+    D=0
+    D=0
+    D=0
+    D=0
+    D=0
+(SKIP)
+    @x
+    D=M
+    @100
+    D=D-A
+    @END
+    D;JEQ
+    D=0
+    @OUTER
+    0;JMP
+(END)
+    @END
+    0;JMP
@@ -0,0 +1,11 @@
+// File name: projects/06/CPUEmulator/test/IdleLoops.tst
+
+load IdleLoops.asm,
+output-file IdleLoops.out,
+compare-to IdleLoops.cmp,
+output-list RAM[16]%D2.6.2 RAM[17]%D2.6.2;
+
+repeat 100000 {
+  ticktock;
+}
+output;